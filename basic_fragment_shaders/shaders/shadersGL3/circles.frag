@@ -0,0 +1,18 @@
+#version 150
+
+uniform vec2 u_resolution;
+uniform float u_time;
+
+out vec4 output_color;
+
+// concentric rings pulsing out from the center, one distance and a few trig calls per fragment
+void main()
+{
+    vec2 st = gl_FragCoord.xy / u_resolution;
+    st.x *= u_resolution.x / u_resolution.y;
+    vec2 center = vec2(0.5 * u_resolution.x / u_resolution.y, 0.5);
+    float r = length(st - center);
+    float rings = 0.5 + 0.5 * cos(40.0 * r - 4.0 * u_time);
+    float falloff = smoothstep(0.7, 0.0, r);
+    output_color = vec4(vec3(rings * falloff), 1.0);
+}
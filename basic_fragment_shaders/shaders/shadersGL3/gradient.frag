@@ -0,0 +1,13 @@
+#version 150
+
+uniform vec2 u_resolution;
+uniform float u_time;
+
+out vec4 output_color;
+
+// cheapest case: one animated colour ramp across the frame
+void main()
+{
+    vec2 st = gl_FragCoord.xy / u_resolution;
+    output_color = vec4(st.x, st.y, 0.5 + 0.5 * sin(u_time), 1.0);
+}
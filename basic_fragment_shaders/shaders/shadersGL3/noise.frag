@@ -0,0 +1,40 @@
+#version 150
+
+uniform vec2 u_resolution;
+uniform float u_time;
+
+out vec4 output_color;
+
+const int octaves = 6;  //!< layers of value noise summed per fragment
+
+float random(vec2 st)
+{
+    return fract(sin(dot(st, vec2(12.9898, 78.233))) * 43758.5453123);
+}
+
+// bilinear value noise with a smoothstep fade
+float noise(vec2 st)
+{
+    vec2 i = floor(st);
+    vec2 f = fract(st);
+    float a = random(i);
+    float b = random(i + vec2(1.0, 0.0));
+    float c = random(i + vec2(0.0, 1.0));
+    float d = random(i + vec2(1.0, 1.0));
+    vec2 u = f * f * (3.0 - 2.0 * f);
+    return mix(a, b, u.x) + (c - a) * u.y * (1.0 - u.x) + (d - b) * u.x * u.y;
+}
+
+// heaviest case: drifting fractal brownian motion
+void main()
+{
+    vec2 st = gl_FragCoord.xy / u_resolution.y * 3.0;
+    float value = 0.0;
+    float amplitude = 0.5;
+    for ( int i = 0; i < octaves; i++ ) {
+        value += amplitude * noise(st + 0.2 * u_time);
+        st *= 2.0;
+        amplitude *= 0.5;
+    }
+    output_color = vec4(vec3(value), 1.0);
+}
@@ -1,15 +1,37 @@
+/**
+ * \file main.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief fragment shader throughput harness startup
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
 #include "ofMain.h"
 #include "ofApp.h"
+#include "shader_options.hpp"
+#include <memory>
 
-//========================================================================
-int main( ){
-	ofGLWindowSettings settings;
-	settings.setGLVersion(3,2);
-	ofCreateWindow(settings);
-
-	// this kicks off the running of my app
-	// can be OF_WINDOW or OF_FULLSCREEN
-	// pass in width and height too:
-	ofRunApp(new ofApp());
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief main application startup function. The shaders render into frame buffers, so the window is only there for the
+ *        GL context and stays hidden (see shader_options.hpp for the flags).
+ *
+ * \param argc number of CLI arguments
+ * \param argv list of arguments
+ * \retval int
+ */
+int main(int argc, char* argv[]) {
+    const auto options = parse_shader_options(argc, argv);
 
+    ofGLFWWindowSettings window_settings;
+    window_settings.setGLVersion(3, 2);
+    window_settings.setSize(320, 240);
+    window_settings.visible = false;
+    ofCreateWindow(window_settings);
+    auto app = std::make_unique<application>(options);
+    return ofRunApp(app.get());
 }
@@ -1,71 +1,47 @@
+/**
+ * \file ofApp.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief runs the fragment shader throughput harness once the GL context is up
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
 #include "ofApp.h"
-
-//--------------------------------------------------------------
-void ofApp::setup(){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::update(){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::draw(){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::keyPressed(int key){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::keyReleased(int key){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mouseMoved(int x, int y ){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mouseDragged(int x, int y, int button){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mousePressed(int x, int y, int button){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mouseReleased(int x, int y, int button){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mouseEntered(int x, int y){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::mouseExited(int x, int y){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::windowResized(int w, int h){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::gotMessage(ofMessage msg){
-
-}
-
-//--------------------------------------------------------------
-void ofApp::dragEvent(ofDragInfo dragInfo){ 
-
-}
+#include "shader_benchmark.hpp"
+
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new application::application object
+ *
+ * \param options shaders, sizes and frame counts to time
+ */
+application::application(const shader_options& options)
+: _options(options) { }
+
+/**
+ * \brief time the shaders and exit with the harness result
+ */
+void application::setup() {
+    ofExit(run_shader_harness(_options));
+}
+
+
+/********************************** Unused Openframeworks API Functions *******************************************/
+void application::update() { }
+void application::draw() { }
+void application::keyPressed(int key) { }
+void application::keyReleased(int key) { }
+void application::mouseMoved(int x, int y) { }
+void application::mouseDragged(int x, int y, int button) { }
+void application::mousePressed(int x, int y, int button) { }
+void application::mouseReleased(int x, int y, int button) { }
+void application::mouseEntered(int x, int y) { }
+void application::mouseExited(int x, int y) { }
+void application::windowResized(int w, int h) { }
+void application::gotMessage(ofMessage msg) { }
+void application::dragEvent(ofDragInfo dragInfo) { }
@@ -1,24 +1,42 @@
+/**
+ * \file ofApp.h
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief runs the fragment shader throughput harness once the GL context is up
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
 #pragma once
 
+/********************************** Includes *******************************************/
 #include "ofMain.h"
+#include "shader_options.hpp"
+
+/********************************** Types *******************************************/
+class application : public ofBaseApp {
+  public:
+    explicit application(const shader_options& options = shader_options{});
 
-class ofApp : public ofBaseApp{
+    void setup();
+    void update();
+    void draw();
 
-	public:
-		void setup();
-		void update();
-		void draw();
+    //!< open frameworks base application interface functions
+    void keyPressed(int key);
+    void keyReleased(int key);
+    void mouseMoved(int x, int y);
+    void mouseDragged(int x, int y, int button);
+    void mousePressed(int x, int y, int button);
+    void mouseReleased(int x, int y, int button);
+    void mouseEntered(int x, int y);
+    void mouseExited(int x, int y);
+    void windowResized(int w, int h);
+    void dragEvent(ofDragInfo dragInfo);
+    void gotMessage(ofMessage msg);
 
-		void keyPressed(int key);
-		void keyReleased(int key);
-		void mouseMoved(int x, int y );
-		void mouseDragged(int x, int y, int button);
-		void mousePressed(int x, int y, int button);
-		void mouseReleased(int x, int y, int button);
-		void mouseEntered(int x, int y);
-		void mouseExited(int x, int y);
-		void windowResized(int w, int h);
-		void dragEvent(ofDragInfo dragInfo);
-		void gotMessage(ofMessage msg);
-		
+  private:
+    shader_options _options;
 };
@@ -0,0 +1,166 @@
+/**
+ * \file shader_benchmark.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief times fragment shaders rendering offscreen and reports the results as JSON
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "shader_benchmark.hpp"
+#include "ofMain.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief get the path of a shader in the sketch shaders directory
+ *
+ * \param name shader file name relative to shaders/shadersGL3
+ * \retval std::filesystem::path
+ */
+static std::filesystem::path shader_path(const std::string& name) {
+    return std::filesystem::current_path().parent_path() / std::filesystem::path{"shaders"} / std::filesystem::path{"shadersGL3"} /
+           std::filesystem::path{name};
+}
+
+/**
+ * \brief draw one frame of a shader over the whole frame buffer and wait for it to finish
+ *
+ * \param shader the shader to draw with
+ * \param target the frame buffer to draw into
+ * \param time_sec value of the u_time uniform
+ */
+static void draw_frame(ofShader& shader, ofFbo& target, float time_sec) {
+    const auto width = target.getWidth();
+    const auto height = target.getHeight();
+    target.begin();
+    shader.begin();
+    shader.setUniform2f("u_resolution", width, height);
+    shader.setUniform1f("u_time", time_sec);
+    ofDrawRectangle(0, 0, width, height);
+    shader.end();
+    target.end();
+    glFinish();
+}
+
+/**
+ * \brief write a string as a quoted JSON string
+ *
+ * \param output stream to write to
+ * \param text the string
+ */
+static void write_json_string(std::ostream& output, const std::string& text) {
+    output << '"';
+    for ( const auto c : text ) {
+        if ( c == '"' || c == '\\' ) {
+            output << '\\' << c;
+        } else if ( static_cast<unsigned char>(c) < 0x20 ) {
+            output << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+            output << c;
+        }
+    }
+    output << '"';
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief render every shader into an offscreen frame buffer at every size and frame count
+ *
+ * \param options shaders, sizes and frame counts to time
+ * \retval std::optional<std::vector<shader_timing>> timings, or nothing if a shader failed to load
+ */
+std::optional<std::vector<shader_timing>> run_shader_benchmark(const shader_options& options) {
+    std::vector<shader_timing> timings;
+    for ( const auto& name : options.shaders ) {
+        ofShader shader;
+        if ( !shader.load(shader_path("fullscreen.vert"), shader_path(name + ".frag")) ) {
+            ofLogError("basic_fragment_shaders") << "could not load shader " << name;
+            return std::nullopt;
+        }
+
+        for ( const auto& size : options.sizes ) {
+            ofFbo target;
+            target.allocate(static_cast<int>(size.width), static_cast<int>(size.height), GL_RGBA);
+            for ( uint64_t frame = 0; frame < options.warmup_frames; frame++ ) {
+                draw_frame(shader, target, static_cast<float>(frame) / 60.0f);
+            }
+
+            for ( const auto frames : options.frame_counts ) {
+                double total_ms = 0;
+                double min_ms = std::numeric_limits<double>::max();
+                double max_ms = 0;
+                for ( uint64_t frame = 0; frame < frames; frame++ ) {
+                    const auto start = std::chrono::steady_clock::now();
+                    draw_frame(shader, target, static_cast<float>(frame) / 60.0f);
+                    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    total_ms += elapsed.count();
+                    min_ms = std::min(min_ms, elapsed.count());
+                    max_ms = std::max(max_ms, elapsed.count());
+                }
+                const auto ms_per_frame = total_ms / static_cast<double>(frames);
+                timings.push_back(shader_timing{
+                    name, size.width, size.height, frames, total_ms, ms_per_frame, min_ms, max_ms, 1000.0 / ms_per_frame});
+            }
+        }
+    }
+    return timings;
+}
+
+/**
+ * \brief write the timings as a JSON document
+ *
+ * \param output stream to write to
+ * \param renderer GL renderer string
+ * \param timings the timings to report
+ */
+void write_shader_report(std::ostream& output, const std::string& renderer, const std::vector<shader_timing>& timings) {
+    output << std::fixed << std::setprecision(3);
+    output << "{\n  \"renderer\": ";
+    write_json_string(output, renderer);
+    output << ",\n  \"results\": [";
+    for ( std::size_t i = 0; i < timings.size(); i++ ) {
+        const auto& timing = timings[i];
+        output << ((i == 0) ? "\n" : ",\n") << "    {\"shader\": ";
+        write_json_string(output, timing.shader);
+        output << ", \"width\": " << timing.width << ", \"height\": " << timing.height << ", \"frames\": " << timing.frames
+               << ", \"total_ms\": " << timing.total_ms << ", \"ms_per_frame\": " << timing.ms_per_frame
+               << ", \"min_ms\": " << timing.min_ms << ", \"max_ms\": " << timing.max_ms << ", \"fps\": " << timing.fps << "}";
+    }
+    output << "\n  ]\n}\n";
+}
+
+/**
+ * \brief run the benchmark and write the report to the file in the options or to stdout
+ *
+ * \param options harness options
+ * \retval int process return value
+ */
+int run_shader_harness(const shader_options& options) {
+    const auto timings = run_shader_benchmark(options);
+    if ( !timings ) {
+        return 1;
+    }
+
+    const auto renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    if ( options.json_path.empty() ) {
+        write_shader_report(std::cout, renderer ? renderer : "unknown", *timings);
+        return 0;
+    }
+    std::ofstream file{options.json_path};
+    if ( !file ) {
+        ofLogError("basic_fragment_shaders") << "could not open " << options.json_path;
+        return 1;
+    }
+    write_shader_report(file, renderer ? renderer : "unknown", *timings);
+    return 0;
+}
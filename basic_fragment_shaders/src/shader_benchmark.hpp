@@ -0,0 +1,64 @@
+/**
+ * \file shader_benchmark.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief times fragment shaders rendering offscreen and reports the results as JSON
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "shader_options.hpp"
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief timing of one shader at one size and frame count
+ */
+struct shader_timing {
+    std::string shader;
+    uint32_t width;
+    uint32_t height;
+    uint64_t frames;
+    double total_ms;      //!< wall time of all timed frames
+    double ms_per_frame;  //!< mean frame time
+    double min_ms;        //!< fastest frame
+    double max_ms;        //!< slowest frame
+    double fps;           //!< frames per second from the mean frame time
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief render every shader into an offscreen frame buffer at every size and frame count. Each frame is a full target
+ *        rectangle followed by glFinish, so the time covers the whole frame even on a software renderer that defers work.
+ *        Must be called with a GL context.
+ *
+ * \param options shaders, sizes and frame counts to time
+ * \retval std::optional<std::vector<shader_timing>> timings, or nothing if a shader failed to load
+ */
+std::optional<std::vector<shader_timing>> run_shader_benchmark(const shader_options& options);
+
+/**
+ * \brief write the timings as a JSON document
+ *
+ * \param output stream to write to
+ * \param renderer GL renderer string, so software and hardware runs can be told apart
+ * \param timings the timings to report
+ */
+void write_shader_report(std::ostream& output, const std::string& renderer, const std::vector<shader_timing>& timings);
+
+/**
+ * \brief run the benchmark and write the report to the file in the options or to stdout
+ *
+ * \param options harness options
+ * \retval int process return value
+ */
+int run_shader_harness(const shader_options& options);
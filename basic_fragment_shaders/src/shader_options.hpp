@@ -0,0 +1,111 @@
+/**
+ * \file shader_options.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief command line options for the fragment shader throughput harness
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief size of an offscreen render target
+ */
+struct render_size {
+    uint32_t width;
+    uint32_t height;
+};
+
+/**
+ * \brief options for the shader harness
+ */
+struct shader_options {
+    std::vector<std::string> shaders = {"gradient", "circles", "noise"};     //!< fragment shaders in shaders/shadersGL3, no extension
+    std::vector<render_size> sizes = {{640, 360}, {1280, 720}, {1920, 1080}};  //!< render target sizes to time each shader at
+    std::vector<uint64_t> frame_counts = {60};                                //!< frames to time at each size
+    uint64_t warmup_frames = 5;                                               //!< untimed frames before each run
+    std::string json_path;                                                    //!< file to write the report to, empty for stdout
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief split a comma separated list and parse each entry
+ *
+ * \param list the comma separated list
+ * \param parse parser for a single entry, returns false to skip it
+ * \retval std::vector<T> parsed entries
+ */
+template <typename T, typename Parser>
+std::vector<T> parse_list(const std::string& list, Parser&& parse) {
+    std::vector<T> entries;
+    std::size_t start = 0;
+    while ( start <= list.size() ) {
+        const auto end = std::min(list.find(',', start), list.size());
+        T entry{};
+        if ( parse(list.substr(start, end - start), entry) ) {
+            entries.push_back(entry);
+        }
+        start = end + 1;
+    }
+    return entries;
+}
+
+/**
+ * \brief parse the shader harness options from the command line. Unknown arguments are ignored.
+ *
+ *        --shader <name>         time shaders/shadersGL3/<name>.frag. Repeat for more shaders. Replaces the defaults.
+ *        --sizes <WxH,...>       render target sizes, e.g. 640x360,1920x1080
+ *        --frames <n,...>        frames to time at each size
+ *        --warmup <n>            untimed frames before each run
+ *        --json <file>           write the report to a file instead of stdout
+ *
+ * \param argc number of CLI arguments
+ * \param argv list of arguments
+ * \retval shader_options
+ */
+inline shader_options parse_shader_options(int argc, char* argv[]) {
+    shader_options options;
+    bool default_shaders = true;
+    for ( int i = 1; i < argc; i++ ) {
+        const std::string argument{argv[i]};
+        const bool has_value = (i + 1) < argc;
+        if ( argument == "--shader" && has_value ) {
+            if ( default_shaders ) {
+                options.shaders.clear();
+                default_shaders = false;
+            }
+            options.shaders.emplace_back(argv[++i]);
+        } else if ( argument == "--sizes" && has_value ) {
+            options.sizes = parse_list<render_size>(argv[++i], [](const std::string& entry, render_size& size) {
+                char* end = nullptr;
+                size.width = static_cast<uint32_t>(std::strtoul(entry.c_str(), &end, 10));
+                if ( (*end != 'x') && (*end != 'X') ) {
+                    return false;
+                }
+                size.height = static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 10));
+                return (size.width > 0) && (size.height > 0);
+            });
+        } else if ( argument == "--frames" && has_value ) {
+            options.frame_counts = parse_list<uint64_t>(argv[++i], [](const std::string& entry, uint64_t& frames) {
+                frames = std::strtoull(entry.c_str(), nullptr, 10);
+                return frames > 0;
+            });
+        } else if ( argument == "--warmup" && has_value ) {
+            options.warmup_frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if ( argument == "--json" && has_value ) {
+            options.json_path = argv[++i];
+        }
+    }
+    return options;
+}
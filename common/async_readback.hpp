@@ -0,0 +1,153 @@
+/**
+ * \file async_readback.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief asynchronous read back of the rendered window through a ring of pixel buffer objects. Each frame queues a
+ *        read into one buffer and collects reads from earlier frames once their fences have signalled, so the
+ *        render loop never waits on the GPU.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "frame_recorder.hpp"
+#include "frame_writer.hpp"
+#include "ofMain.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/********************************** Functions *******************************************/
+/**
+ * \brief create an image encoder that saves frames through open frameworks (used for PNG output)
+ *
+ * \retval image_encoder
+ */
+inline image_encoder of_image_encoder() {
+    return [](const std::string& path, const uint8_t* pixels, std::size_t width, std::size_t height, std::size_t channels) {
+        ofPixels image;
+        image.setFromPixels(pixels, width, height, channels);
+        return ofSaveImage(image, path);
+    };
+}
+
+/********************************** Types *******************************************/
+/**
+ * \brief pixel buffer object ring for reading back the default framebuffer without stalling
+ */
+class async_readback {
+  public:
+    static constexpr std::size_t channels = 4;  //!< read RGBA, which is the native fast path on most drivers
+
+    /**
+     * \brief Construct a new async readback object. Must be created after the GL context.
+     *
+     * \param depth number of frames that can be in flight
+     */
+    explicit async_readback(std::size_t depth = 3)
+        : _transfers(depth)
+        , _next(0) {
+        for ( auto& transfer : _transfers ) {
+            glGenBuffers(1, &transfer.buffer);
+        }
+    }
+
+    ~async_readback() {
+        for ( auto& transfer : _transfers ) {
+            if ( transfer.fence ) {
+                glDeleteSync(transfer.fence);
+            }
+            glDeleteBuffers(1, &transfer.buffer);
+        }
+    }
+
+    async_readback(const async_readback&) = delete;
+    async_readback& operator=(const async_readback&) = delete;
+
+    /**
+     * \brief hand any completed reads to the recorder and queue a read of the current framebuffer. If every buffer is
+     *        still in flight the frame is counted as dropped rather than waiting.
+     *
+     * \param recorder recorder to pass finished frames to
+     */
+    void capture(frame_recorder& recorder) {
+        collect(recorder, false);
+
+        auto& transfer = _transfers[_next];
+        if ( transfer.fence ) {
+            recorder.count_dropped();
+            return;
+        }
+
+        transfer.width = ofGetWidth();
+        transfer.height = ofGetHeight();
+        const auto size = static_cast<std::size_t>(transfer.width) * transfer.height * channels;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer);
+        if ( transfer.size != size ) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+            transfer.size = size;
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, transfer.width, transfer.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        transfer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _order.push_back(_next);
+        _next = (_next + 1) % _transfers.size();
+    }
+
+    /**
+     * \brief wait for every in-flight read and hand it to the recorder. Used when recording stops.
+     *
+     * \param recorder recorder to pass finished frames to
+     */
+    void flush(frame_recorder& recorder) {
+        collect(recorder, true);
+    }
+
+  private:
+    struct transfer {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        std::size_t size = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * \brief collect finished reads in the order they were issued
+     *
+     * \param recorder recorder to pass frames to
+     * \param wait block on fences that have not signalled
+     */
+    void collect(frame_recorder& recorder, bool wait) {
+        while ( !_order.empty() ) {
+            auto& transfer = _transfers[_order.front()];
+            const auto status = glClientWaitSync(transfer.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? UINT64_MAX : 0);
+            if ( (status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED) ) {
+                return;
+            }
+            glDeleteSync(transfer.fence);
+            transfer.fence = nullptr;
+            _order.erase(_order.begin());
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer);
+            const auto* pixels = static_cast<const uint8_t*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+            if ( pixels ) {
+                recorder.push(pixels, transfer.width, transfer.height, channels, true);
+            } else {
+                recorder.count_dropped();
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+    }
+
+    std::vector<transfer> _transfers;
+    std::vector<std::size_t> _order;  //!< in-flight transfers, oldest first
+    std::size_t _next;
+};
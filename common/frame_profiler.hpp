@@ -0,0 +1,250 @@
+/**
+ * \file frame_profiler.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief lightweight per-stage frame timing for the sketches. Timings are recorded into a lock-free ring buffer
+ *        and can be summarized as percentiles or dumped as CSV / chrome trace events.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief a single timing sample copied out of the ring buffer
+ */
+struct profile_sample {
+    uint32_t stage;        //!< index of the stage that was timed
+    uint32_t thread;       //!< small integer id of the recording thread
+    uint64_t start_ns;     //!< start time relative to the profiler creation
+    uint64_t duration_ns;  //!< duration of the stage
+};
+
+/**
+ * \brief summary statistics for one stage over the samples currently in the ring buffer
+ */
+struct stage_statistics {
+    std::size_t count = 0;
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+};
+
+/**
+ * \brief frame profiler. Any thread can record samples without locking: each writer claims a slot with an atomic increment
+ *        and publishes it with a sequence number, so readers can skip slots that are being overwritten. When the profiler is
+ *        disabled a scope costs a single relaxed load.
+ */
+class frame_profiler {
+  public:
+    using clock = std::chrono::steady_clock;
+    using clock_time = clock::time_point;
+
+    static constexpr std::size_t capacity = 4096;  //!< ring size in samples, must be a power of two
+
+    /**
+     * \brief RAII timer that records the time between its construction and destruction against a stage
+     */
+    class scope {
+      public:
+        scope(frame_profiler& profiler, uint32_t stage)
+            : _profiler(profiler.enabled() ? &profiler : nullptr)
+            , _stage(stage)
+            , _start(_profiler ? clock::now() : clock::time_point{}) { }
+
+        ~scope() {
+            if ( _profiler ) {
+                _profiler->record(_stage, _start, clock::now());
+            }
+        }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+      private:
+        frame_profiler* _profiler;
+        uint32_t _stage;
+        clock_time _start;
+    };
+
+    /**
+     * \brief Construct a new frame profiler object
+     *
+     * \param stage_names names of the stages. Stage ids are the index of the name in this list.
+     * \param enabled whether recording starts enabled
+     */
+    frame_profiler(std::initializer_list<const char*> stage_names, bool enabled = false)
+        : _stage_names(stage_names.begin(), stage_names.end())
+        , _head(0)
+        , _enabled(enabled)
+        , _epoch(clock::now()) {
+        for ( auto& slot : _slots ) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool enabled() const {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void set_enabled(bool enabled) {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    const std::vector<const char*>& stage_names() const {
+        return _stage_names;
+    }
+
+    /**
+     * \brief record a timing sample
+     *
+     * \param stage the stage id
+     * \param start when the stage started
+     * \param end when the stage finished
+     */
+    void record(uint32_t stage, clock_time start, clock_time end) {
+        const auto index = _head.fetch_add(1, std::memory_order_relaxed);
+        auto& slot = _slots[index & (capacity - 1)];
+        //!< seqlock: the fence keeps the payload stores below from becoming visible before the zero
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.stage.store(stage, std::memory_order_relaxed);
+        slot.thread.store(thread_id(), std::memory_order_relaxed);
+        slot.start_ns.store(to_ns(start - _epoch), std::memory_order_relaxed);
+        slot.duration_ns.store(to_ns(end - start), std::memory_order_relaxed);
+        slot.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * \brief copy the samples currently held in the ring buffer, oldest first. Slots that are mid-write are skipped.
+     *
+     * \retval std::vector<profile_sample>
+     */
+    std::vector<profile_sample> snapshot() const {
+        const auto head = _head.load(std::memory_order_acquire);
+        const auto first = (head > capacity) ? head - capacity : 0;
+        std::vector<profile_sample> samples;
+        samples.reserve(head - first);
+        for ( auto index = first; index < head; index++ ) {
+            const auto& slot = _slots[index & (capacity - 1)];
+            if ( slot.sequence.load(std::memory_order_acquire) != index + 1 ) {
+                continue;
+            }
+            profile_sample sample{slot.stage.load(std::memory_order_relaxed),
+                                  slot.thread.load(std::memory_order_relaxed),
+                                  slot.start_ns.load(std::memory_order_relaxed),
+                                  slot.duration_ns.load(std::memory_order_relaxed)};
+            //!< the fence keeps the payload loads above from moving after the re-check
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ( slot.sequence.load(std::memory_order_relaxed) == index + 1 ) {
+                samples.push_back(sample);
+            }
+        }
+        return samples;
+    }
+
+    /**
+     * \brief calculate percentiles for every stage from a snapshot
+     *
+     * \param samples the snapshot of samples
+     * \retval std::vector<stage_statistics> one entry per stage
+     */
+    std::vector<stage_statistics> summarize(const std::vector<profile_sample>& samples) const {
+        std::vector<stage_statistics> statistics(_stage_names.size());
+        std::vector<uint64_t> durations;
+        for ( uint32_t stage = 0; stage < _stage_names.size(); stage++ ) {
+            durations.clear();
+            for ( const auto& sample : samples ) {
+                if ( sample.stage == stage ) {
+                    durations.push_back(sample.duration_ns);
+                }
+            }
+            if ( durations.empty() ) {
+                continue;
+            }
+            std::sort(durations.begin(), durations.end());
+            auto percentile = [&durations](double p) { return durations[static_cast<std::size_t>(p * (durations.size() - 1))] / 1.0e6; };
+            statistics[stage] = stage_statistics{durations.size(), percentile(0.50), percentile(0.90), percentile(0.99), durations.back() / 1.0e6};
+        }
+        return statistics;
+    }
+
+    /**
+     * \brief write the samples in the ring buffer as CSV with one row per sample
+     *
+     * \param path output file path
+     * \retval true if the file was written
+     */
+    bool write_csv(const std::string& path) const {
+        std::ofstream file{path};
+        file << "stage,thread,start_us,duration_us\n";
+        for ( const auto& sample : snapshot() ) {
+            file << stage_name(sample.stage) << "," << sample.thread << "," << sample.start_ns / 1000.0 << "," << sample.duration_ns / 1000.0 << "\n";
+        }
+        return file.good();
+    }
+
+    /**
+     * \brief write the samples in the ring buffer in the chrome trace event format (chrome://tracing, perfetto)
+     *
+     * \param path output file path
+     * \retval true if the file was written
+     */
+    bool write_chrome_trace(const std::string& path) const {
+        std::ofstream file{path};
+        file << "{\"traceEvents\":[";
+        bool first = true;
+        for ( const auto& sample : snapshot() ) {
+            file << (first ? "\n" : ",\n") << "{\"name\":\"" << stage_name(sample.stage) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << sample.thread
+                 << ",\"ts\":" << sample.start_ns / 1000.0 << ",\"dur\":" << sample.duration_ns / 1000.0 << "}";
+            first = false;
+        }
+        file << "\n]}\n";
+        return file.good();
+    }
+
+  private:
+    struct slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint32_t> stage;
+        std::atomic<uint32_t> thread;
+        std::atomic<uint64_t> start_ns;
+        std::atomic<uint64_t> duration_ns;
+    };
+
+    static uint64_t to_ns(clock::duration duration) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    static uint32_t thread_id() {
+        static std::atomic<uint32_t> next_id{0};
+        thread_local const uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    const char* stage_name(uint32_t stage) const {
+        return (stage < _stage_names.size()) ? _stage_names[stage] : "unknown";
+    }
+
+    std::vector<const char*> _stage_names;
+    std::array<slot, capacity> _slots;
+    std::atomic<uint64_t> _head;
+    std::atomic<bool> _enabled;
+    clock_time _epoch;
+};
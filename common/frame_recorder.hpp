@@ -0,0 +1,198 @@
+/**
+ * \file frame_recorder.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief hands finished frames to a writer thread through a bounded queue so that the render loop never blocks on disk I/O
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "frame_writer.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief what to do when the writer falls behind and the queue is full
+ */
+enum class queue_policy : unsigned { drop_when_full = 0, block_when_full };
+
+/**
+ * \brief asynchronous frame recorder. Frame buffers are allocated once into a fixed pool the size of the queue; pushing copies
+ *        into a free buffer and the writer thread returns it to the pool after encoding.
+ */
+class frame_recorder {
+  public:
+    /**
+     * \brief Construct a new frame recorder object and start the writer thread
+     *
+     * \param writer the writer that encodes frames
+     * \param queue_depth maximum number of frames waiting to be written
+     * \param policy drop or block when the queue is full
+     */
+    frame_recorder(frame_writer&& writer, std::size_t queue_depth = 8, queue_policy policy = queue_policy::drop_when_full)
+        : _writer(std::move(writer))
+        , _policy(policy)
+        , _slots(std::max<std::size_t>(queue_depth, 1))
+        , _stopping(false)
+        , _written(0)
+        , _dropped(0)
+        , _failed(0) {
+        for ( std::size_t i = 0; i < _slots.size(); i++ ) {
+            _free.push_back(i);
+        }
+        _thread = std::thread([this]() { writer_loop(); });
+    }
+
+    /**
+     * \brief Destroy the frame recorder object once every queued frame has been written
+     */
+    ~frame_recorder() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _signal.notify_all();
+        _thread.join();
+    }
+
+    frame_recorder(const frame_recorder&) = delete;
+    frame_recorder& operator=(const frame_recorder&) = delete;
+
+    /**
+     * \brief queue a frame for writing
+     *
+     * \param pixels row major 8-bit pixels
+     * \param width frame width
+     * \param height frame height
+     * \param channels interleaved channels per pixel
+     * \param flip_rows write the rows bottom to top (GL read back order)
+     * \retval true if the frame was queued, false if it was dropped
+     */
+    bool push(const uint8_t* pixels, std::size_t width, std::size_t height, std::size_t channels, bool flip_rows = false) {
+        std::size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if ( _policy == queue_policy::block_when_full ) {
+                _signal.wait(lock, [this]() { return !_free.empty(); });
+            } else if ( _free.empty() ) {
+                _dropped++;
+                return false;
+            }
+            index = _free.front();
+            _free.pop_front();
+        }
+
+        //!< the slot is owned by this thread until it is queued, so copy outside the lock
+        auto& slot = _slots[index];
+        const auto row_size = width * channels;
+        slot.width = width;
+        slot.height = height;
+        slot.channels = channels;
+        slot.pixels.resize(row_size * height);
+        if ( flip_rows ) {
+            for ( std::size_t row = 0; row < height; row++ ) {
+                std::memcpy(slot.pixels.data() + row * row_size, pixels + (height - row - 1) * row_size, row_size);
+            }
+        } else {
+            std::memcpy(slot.pixels.data(), pixels, row_size * height);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ready.push_back(index);
+        }
+        _signal.notify_all();
+        return true;
+    }
+
+    /**
+     * \brief block until every queued frame has been written
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _signal.wait(lock, [this]() { return _free.size() == _slots.size(); });
+    }
+
+    /**
+     * \brief record a frame that was dropped before it reached the queue (for example a read back that was not ready)
+     */
+    void count_dropped() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _dropped++;
+    }
+
+    uint64_t written() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _written;
+    }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _dropped;
+    }
+
+    uint64_t failed() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _failed;
+    }
+
+  private:
+    struct frame {
+        std::size_t width = 0;
+        std::size_t height = 0;
+        std::size_t channels = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    /**
+     * \brief writer thread, runs until stopped and the queue is empty
+     */
+    void writer_loop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while ( true ) {
+            _signal.wait(lock, [this]() { return !_ready.empty() || _stopping; });
+            if ( _ready.empty() ) {
+                return;
+            }
+            const auto index = _ready.front();
+            _ready.pop_front();
+            lock.unlock();
+
+            //!< a frame that doesn't match the size of the output stream (the window was resized) counts as dropped
+            const auto& slot = _slots[index];
+            const auto accepted = _writer.accepts(slot.width, slot.height, slot.channels);
+            const auto success = _writer.write(slot.pixels.data(), slot.width, slot.height, slot.channels);
+
+            lock.lock();
+            (success ? _written : (accepted ? _failed : _dropped))++;
+            _free.push_back(index);
+            _signal.notify_all();
+        }
+    }
+
+    frame_writer _writer;
+    queue_policy _policy;
+    std::vector<frame> _slots;
+    std::deque<std::size_t> _free;
+    std::deque<std::size_t> _ready;
+    mutable std::mutex _mutex;
+    std::condition_variable _signal;
+    std::thread _thread;
+    bool _stopping;
+    uint64_t _written;
+    uint64_t _dropped;
+    uint64_t _failed;
+};
@@ -0,0 +1,215 @@
+/**
+ * \file frame_writer.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief writes 8-bit frames to disk as numbered PGM/PPM or PNG files, a raw stream, or a Y4M video stream
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "sketch_options.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief hook for image formats that need an external library (PNG).
+ *        encoder :: path -> pixels -> width -> height -> channels -> success
+ */
+using image_encoder = std::function<bool(const std::string&, const uint8_t*, std::size_t, std::size_t, std::size_t)>;
+
+/**
+ * \brief writer for 8-bit frames with 1 (grayscale), 3 (RGB) or 4 (RGBA) interleaved channels
+ */
+class frame_writer {
+  public:
+    /**
+     * \brief Construct a new frame writer object
+     *
+     * \param format the output format
+     * \param path output directory for numbered image frames, or output file for a stream
+     * \param fps frame rate written into stream headers
+     * \param encoder encoder used for PNG frames
+     */
+    frame_writer(frame_format format, const std::string& path, unsigned fps = 60, image_encoder encoder = {})
+        : _format(format)
+        , _path(path)
+        , _fps(fps)
+        , _encoder(std::move(encoder))
+        , _frame_count(0)
+        , _rejected_count(0)
+        , _stream_width(0)
+        , _stream_height(0)
+        , _stream_channels(0) {
+        if ( (_format == frame_format::pgm) || (_format == frame_format::png) ) {
+            std::filesystem::create_directories(_path);
+        } else if ( (_format == frame_format::raw) || (_format == frame_format::y4m) ) {
+            _stream.open(_path, std::ios::binary | std::ios::trunc);
+        }
+    }
+
+    /**
+     * \brief write a single frame
+     *
+     * \param pixels row major 8-bit pixel buffer
+     * \param width frame width in pixels
+     * \param height frame height in pixels
+     * \param channels interleaved channels per pixel
+     * \retval true if the frame was written (or no output was requested). False if it failed or was rejected.
+     */
+    bool write(const uint8_t* pixels, std::size_t width, std::size_t height, std::size_t channels = 1) {
+        if ( !accepts(width, height, channels) ) {
+            if ( _rejected_count++ == 0 ) {
+                std::cerr << "frame_writer: dropping " << width << "x" << height << "x" << channels << " frames, " << _path.string()
+                          << " was started with " << _stream_width << "x" << _stream_height << "x" << _stream_channels << " frames\n";
+            }
+            return false;
+        }
+        if ( is_stream() && (_frame_count == 0) ) {
+            _stream_width = width;
+            _stream_height = height;
+            _stream_channels = channels;
+        }
+
+        const auto size = static_cast<std::streamsize>(width * height * channels);
+        switch ( _format ) {
+            case frame_format::pgm: {
+                //!< alpha is dropped since netpbm has no RGBA variant
+                std::ofstream file{numbered_path((channels == 1) ? "pgm" : "ppm"), std::ios::binary};
+                file << ((channels == 1) ? "P5\n" : "P6\n") << width << " " << height << "\n255\n";
+                if ( channels == 4 ) {
+                    write_rgb(file, pixels, width * height);
+                } else {
+                    file.write(reinterpret_cast<const char*>(pixels), size);
+                }
+                _frame_count++;
+                return file.good();
+            }
+
+            case frame_format::png: {
+                const auto success = _encoder && _encoder(numbered_path("png").string(), pixels, width, height, channels);
+                _frame_count++;
+                return success;
+            }
+
+            case frame_format::raw:
+                _stream.write(reinterpret_cast<const char*>(pixels), size);
+                _frame_count++;
+                return _stream.good();
+
+            case frame_format::y4m:
+                write_y4m(pixels, width, height, channels);
+                _frame_count++;
+                return _stream.good();
+
+            default:
+                return true;
+        }
+    }
+
+    /**
+     * \brief check if a frame can be written. Raw and Y4M streams keep the size of their first frame, which is in the Y4M
+     *        header, so frames of any other size or channel count are rejected. Numbered image files take any size.
+     *
+     * \param width frame width in pixels
+     * \param height frame height in pixels
+     * \param channels interleaved channels per pixel
+     * \retval true if write would append the frame
+     */
+    bool accepts(std::size_t width, std::size_t height, std::size_t channels) const {
+        if ( !is_stream() || (_frame_count == 0) ) {
+            return true;
+        }
+        return (width == _stream_width) && (height == _stream_height) && (channels == _stream_channels);
+    }
+
+    /**
+     * \brief get the number of frames rejected because their size did not match the stream
+     *
+     * \retval uint64_t rejected frame count
+     */
+    uint64_t rejected_count() const {
+        return _rejected_count;
+    }
+
+    /**
+     * \brief get the number of frames written
+     *
+     * \retval uint64_t frame count
+     */
+    uint64_t frame_count() const {
+        return _frame_count;
+    }
+
+  private:
+    bool is_stream() const {
+        return (_format == frame_format::raw) || (_format == frame_format::y4m);
+    }
+
+    std::filesystem::path numbered_path(const char* extension) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06llu.%s", static_cast<unsigned long long>(_frame_count), extension);
+        return _path / name;
+    }
+
+    void write_rgb(std::ofstream& file, const uint8_t* pixels, std::size_t count) {
+        _scratch.resize(count * 3);
+        for ( std::size_t i = 0; i < count; i++ ) {
+            std::copy_n(pixels + i * 4, 3, _scratch.data() + i * 3);
+        }
+        file.write(reinterpret_cast<const char*>(_scratch.data()), static_cast<std::streamsize>(_scratch.size()));
+    }
+
+    /**
+     * \brief write a Y4M frame. Grayscale frames are written as mono, colour frames are converted to BT.601 4:4:4
+     */
+    void write_y4m(const uint8_t* pixels, std::size_t width, std::size_t height, std::size_t channels) {
+        if ( _frame_count == 0 ) {
+            _stream << "YUV4MPEG2 W" << width << " H" << height << " F" << _fps << ":1 Ip A1:1 " << ((channels == 1) ? "Cmono" : "C444") << "\n";
+        }
+        _stream << "FRAME\n";
+        const auto count = width * height;
+        if ( channels == 1 ) {
+            _stream.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(count));
+            return;
+        }
+        _scratch.resize(count * 3);
+        uint8_t* y_plane = _scratch.data();
+        uint8_t* u_plane = y_plane + count;
+        uint8_t* v_plane = u_plane + count;
+        for ( std::size_t i = 0; i < count; i++ ) {
+            const int r = pixels[i * channels + 0];
+            const int g = pixels[i * channels + 1];
+            const int b = pixels[i * channels + 2];
+            y_plane[i] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            u_plane[i] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v_plane[i] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+        _stream.write(reinterpret_cast<const char*>(_scratch.data()), static_cast<std::streamsize>(_scratch.size()));
+    }
+
+    frame_format _format;
+    std::filesystem::path _path;
+    unsigned _fps;
+    image_encoder _encoder;
+    std::ofstream _stream;
+    std::vector<uint8_t> _scratch;
+    uint64_t _frame_count;
+    uint64_t _rejected_count;
+    std::size_t _stream_width;     //!< size of the first frame of a raw or Y4M stream
+    std::size_t _stream_height;
+    std::size_t _stream_channels;
+};
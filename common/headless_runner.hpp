@@ -0,0 +1,70 @@
+/**
+ * \file headless_runner.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief runs a height field engine without a window or GL context so that sketches can be
+ *        profiled and captured on machines without a display
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "frame_recorder.hpp"
+#include "frame_writer.hpp"
+#include "sketch_options.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/********************************** Functions *******************************************/
+/**
+ * \brief run a height field engine for a fixed number of frames on a fixed step clock. The engine must provide:
+ *
+ *        std::size_t width() const            -> width of the field in pixels
+ *        std::size_t height() const           -> height of the field in pixels
+ *        bool update(double time_sec)         -> advance to a time, returns true if the output changed
+ *        void fill(uint8_t* pixels) const     -> write the current field as row major 8-bit values
+ *
+ * \tparam Engine the simulation engine type
+ * \param engine the engine to run
+ * \param options the sketch options
+ * \param encoder encoder for PNG output
+ * \retval int process return value
+ */
+template <typename Engine>
+int run_headless(Engine& engine, const sketch_options& options, image_encoder encoder = {}) {
+    auto clock = options.make_clock();
+    std::vector<uint8_t> pixels(engine.width() * engine.height(), 0);
+    double elapsed_sec = 0;
+    uint64_t failed = 0;
+    {
+        //!< frames are written on the recorder thread. Headless runs block rather than drop so captures are complete.
+        frame_recorder recorder{frame_writer{options.format, options.output_path, options.record_fps(), std::move(encoder)}, 8, queue_policy::block_when_full};
+        const auto start = std::chrono::steady_clock::now();
+        for ( uint64_t frame = 0; frame < options.frames; frame++ ) {
+            if ( engine.update(clock.tick()) ) {
+                engine.fill(pixels.data());
+            }
+            if ( options.format != frame_format::none ) {
+                recorder.push(pixels.data(), engine.width(), engine.height(), 1);
+            }
+        }
+        elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        recorder.flush();
+        failed = recorder.failed();
+    }
+
+    std::cout << "frames: " << options.frames << ", field: " << engine.width() << "x" << engine.height()
+              << ", simulated: " << clock.seconds() << " s, wall: " << elapsed_sec << " s, "
+              << (elapsed_sec > 0.0 ? options.frames / elapsed_sec : 0.0) << " frames/s" << std::endl;
+    if ( failed > 0 ) {
+        std::cerr << "failed to write " << failed << " frames to " << options.output_path << std::endl;
+        return 1;
+    }
+    return 0;
+}
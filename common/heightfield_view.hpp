@@ -0,0 +1,497 @@
+/**
+ * \file heightfield_view.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief reusable pipeline that runs a height field engine, uploads its output to a texture and renders it
+ *        as a displaced wireframe plane
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "async_readback.hpp"
+#include "frame_profiler.hpp"
+#include "frame_recorder.hpp"
+#include "ofMain.h"
+#include "profiler_overlay.hpp"
+#include "resolution_controller.hpp"
+#include "sketch_options.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/********************************** Constants *******************************************/
+//!< fraction of the engine's initial size at each adaptive resolution level, finest first
+constexpr std::array<float, 5> resolution_scales = {1.0f, 0.75f, 0.5f, 0.375f, 0.25f};
+constexpr std::size_t min_resolution = 8;  //!< levels smaller than this many pixels on a side are skipped
+
+/********************************** Functions *******************************************/
+/**
+ * \brief hash a frame so that a repeated frame can be detected without keeping a copy of the previous one
+ *
+ * \param pixels the frame
+ * \param size number of bytes
+ * \retval uint64_t
+ */
+inline uint64_t frame_checksum(const uint8_t* pixels, std::size_t size) {
+    constexpr uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    uint64_t hash = size;
+    std::size_t i = 0;
+    for ( ; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t) ) {
+        uint64_t word;
+        std::memcpy(&word, pixels + i, sizeof(word));
+        hash = (hash ^ (word * multiplier)) * multiplier;
+        hash ^= hash >> 29;
+    }
+    for ( ; i < size; i++ ) {
+        hash = (hash ^ pixels[i]) * multiplier;
+    }
+    return hash;
+}
+
+/********************************** Types *******************************************/
+/**
+ * \brief settings for the rendered height field
+ */
+struct heightfield_settings {
+    float plane_width = 1200;                //!< width of the plane in world units
+    float plane_height = 900;                //!< height of the plane in world units
+    int mesh_columns = 0;                    //!< wireframe columns. Zero uses the field width
+    int mesh_rows = 0;                       //!< wireframe rows. Zero uses the field height
+    std::string shader = "shadersGL3/shader";  //!< displacement shader path relative to the shaders directory
+    std::string scale_uniform = "u_scale";   //!< name of the displacement scale uniform in the shader
+};
+
+/**
+ * \brief height field pipeline. Owns the pixel buffers, the worker thread that runs the engine, the texture upload and the
+ *        wireframe mesh so that every sketch gets the same (and any future) performance work for free. The engine must provide:
+ *
+ *        std::size_t width() const            -> width of the field in pixels
+ *        std::size_t height() const           -> height of the field in pixels
+ *        bool update(double time_sec)         -> advance to a time, returns true if the output changed
+ *        void fill(uint8_t* pixels) const     -> write the current field as row major 8-bit values
+ *        void resize(std::size_t width,       -> change the resolution, keeping the field's extent. Only called when
+ *                    std::size_t height)         adaptive resolution is enabled
+ *
+ *        When threaded, frame N is simulated on the worker while frame N - 1 is uploaded and drawn, so the displayed field lags
+ *        the clock by one frame. When an output format is given the rendered window is recorded through an asynchronous read back.
+ *
+ *        A frame is only swapped in and uploaded when the engine reports a change and its checksum differs from the frame on
+ *        screen, so a field that has settled costs neither an evaluation nor an upload.
+ *
+ *        With a frame time target the update and draw time of each frame feeds a resolution controller that steps the engine
+ *        through a fixed set of coarser levels. The pixel buffers, texture and mesh of every level are allocated up front, so
+ *        a level change only resizes the engine and switches which set is in use.
+ *
+ * \tparam Engine the height field engine
+ */
+template <typename Engine>
+class heightfield_view {
+  public:
+    //!< stages timed by the frame profiler
+    enum profile_stage : uint32_t { stage_simulate = 0, stage_fill, stage_upload, stage_draw_wireframe };
+
+    /**
+     * \brief Construct a new heightfield view object. Must be created after the GL context.
+     *
+     * \param engine the simulation engine
+     * \param settings render settings
+     * \param options sketch options
+     */
+    heightfield_view(Engine&& engine, const heightfield_settings& settings, const sketch_options& options)
+        : _engine(std::move(engine))
+        , _settings(settings)
+        , _profiler({"simulate", "fill", "upload", "draw_wireframe"}, options.profile)
+        , _level(0)
+        , _output_path(options.output_path)
+        , _recording(false)
+        , _threaded(options.threaded)
+        , _job_pending(false)
+        , _job_changed(false)
+        , _stopping(false) {
+        const auto scales = (options.target_frame_ms > 0.0) ? resolution_scales.size() : 1;
+        _levels.reserve(scales);
+        std::vector<double> costs;
+        for ( std::size_t i = 0; i < scales; i++ ) {
+            const auto scale = resolution_scales[i];
+            const auto width = static_cast<std::size_t>(_engine.width() * scale + 0.5f);
+            const auto height = static_cast<std::size_t>(_engine.height() * scale + 0.5f);
+            if ( (i > 0) && (std::min(width, height) < min_resolution) ) {
+                break;
+            }
+            allocate_level(width, height, scale);
+            costs.push_back(static_cast<double>(width * height));
+        }
+        _shown_checksum = frame_checksum(_levels[0].front.getData(), _levels[0].front.size());
+        if ( _levels.size() > 1 ) {
+            resolution_settings resolution;
+            resolution.target_ms = options.target_frame_ms;
+            _resolution.emplace(std::move(costs), 0, resolution);
+        }
+        if ( options.format != frame_format::none ) {
+            _recorder = std::make_unique<frame_recorder>(frame_writer{options.format, options.output_path, options.record_fps(), of_image_encoder()});
+            _readback = std::make_unique<async_readback>();
+            _recording = true;
+        }
+        if ( _threaded ) {
+            _worker = std::thread([this]() { worker_loop(); });
+        }
+    }
+
+    ~heightfield_view() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _signal.notify_all();
+        if ( _worker.joinable() ) {
+            _worker.join();
+        }
+    }
+
+    heightfield_view(const heightfield_view&) = delete;
+    heightfield_view& operator=(const heightfield_view&) = delete;
+
+    /**
+     * \brief load the displacement shader from the sketch shaders directory
+     */
+    void setup() {
+        auto path = std::filesystem::current_path();
+        auto parent_path = path.parent_path();
+        std::filesystem::path shader_path = parent_path / std::filesystem::path{"shaders"};
+        _displacement_shader.load(shader_path / std::filesystem::path{_settings.shader});
+    }
+
+    /**
+     * \brief present the most recently simulated frame and start simulating the next one
+     *
+     * \param time_sec simulation time of the next frame
+     */
+    void update(double time_sec) {
+        _frame_start = std::chrono::steady_clock::now();
+        if ( !_threaded ) {
+            //!< keep a pending level change from set_level so the refilled frame is still swapped in
+            _job_changed = simulate(time_sec) || _job_changed;
+            present();
+            return;
+        }
+        wait_idle();
+        present();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job_time = time_sec;
+            _job_pending = true;
+        }
+        _signal.notify_all();
+    }
+
+    /**
+     * \brief render the height field as a displaced wireframe
+     *
+     * \param scale displacement scale passed to the shader
+     */
+    void draw(float scale) {
+        //!< bind the texture to the shader
+        auto& level = _levels[_level];
+        level.texture.bind();
+
+        //!< start the shader
+        _displacement_shader.begin();
+        _displacement_shader.setUniform1f(_settings.scale_uniform, scale);
+
+        //!< push the current local coordinate system to move to a new relative one
+        ofPushMatrix();
+
+        //!< translate the plane into the center of the screen
+        auto center_x = ofGetWidth() / 2.0;
+        auto center_y = ofGetHeight() / 2.0;
+        ofTranslate(center_x, center_y);
+
+        //!< rotate it to a more isometric view
+        auto rotation = ofMap(0.30, 0, 1, -60, 60, true) + 60;
+        ofRotateDeg(rotation, 1, 0, 0);
+
+        //!< keep the plane transform so that screen positions can be mapped back onto the field
+        _plane_to_clip = ofGetCurrentMatrix(OF_MATRIX_PROJECTION) * ofGetCurrentMatrix(OF_MATRIX_MODELVIEW);
+        _viewport = ofGetCurrentViewport();
+
+        //!< draw the wireframe. Note this only times the CPU side of the draw call submission
+        {
+            frame_profiler::scope timer{_profiler, stage_draw_wireframe};
+            level.plane.drawWireframe();
+        }
+
+        ofPopMatrix();
+        _displacement_shader.end();
+        level.texture.unbind();
+
+        //!< capture before the overlay so it doesn't end up in recordings
+        if ( _recording ) {
+            _readback->capture(*_recorder);
+        }
+
+        if ( _profiler.enabled() ) {
+            draw_profiler_overlay(_profiler);
+        }
+
+        if ( _resolution ) {
+            const auto frame_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _frame_start).count();
+            if ( auto next = _resolution->record(frame_ms) ) {
+                set_level(*next);
+            }
+        }
+    }
+
+    /**
+     * \brief get the engine. This waits for any in-flight simulation so the caller has exclusive access.
+     *
+     * \retval Engine&
+     */
+    Engine& engine() {
+        wait_idle();
+        return _engine;
+    }
+
+    /**
+     * \brief get the pixels of the frame that is currently displayed
+     *
+     * \retval const ofPixels&
+     */
+    const ofPixels& pixels() const {
+        return _levels[_level].front;
+    }
+
+    frame_profiler& profiler() {
+        return _profiler;
+    }
+
+    /**
+     * \brief map a screen position (e.g. the mouse) onto the field by intersecting its view ray with the undisplaced plane
+     *        as it was last drawn
+     *
+     * \param x screen x in pixels
+     * \param y screen y in pixels
+     * \retval std::optional<glm::vec2> column and row in field pixels, or nothing if the position misses the plane
+     */
+    std::optional<glm::vec2> screen_to_field(float x, float y) const {
+        if ( (_viewport.width <= 0) || (_viewport.height <= 0) ) {
+            return std::nullopt;
+        }
+        const auto clip_to_plane = glm::inverse(_plane_to_clip);
+        const auto ndc_x = 2.0f * (x - _viewport.x) / _viewport.width - 1.0f;
+        const auto ndc_y = 1.0f - 2.0f * (y - _viewport.y) / _viewport.height;
+        auto near_point = clip_to_plane * glm::vec4(ndc_x, ndc_y, -1.0f, 1.0f);
+        auto far_point = clip_to_plane * glm::vec4(ndc_x, ndc_y, 1.0f, 1.0f);
+        near_point /= near_point.w;
+        far_point /= far_point.w;
+
+        const auto direction = far_point - near_point;
+        if ( std::abs(direction.z) < 1e-6f ) {
+            return std::nullopt;
+        }
+        const auto point = near_point + (-near_point.z / direction.z) * direction;
+
+        //!< the plane primitive maps its bottom edge (-y) to the last row of the texture
+        const auto column = (point.x / _settings.plane_width + 0.5f) * static_cast<float>(_engine.width());
+        const auto row = (0.5f - point.y / _settings.plane_height) * static_cast<float>(_engine.height());
+        if ( (column < 0) || (row < 0) || (column >= _engine.width()) || (row >= _engine.height()) ) {
+            return std::nullopt;
+        }
+        return glm::vec2{column, row};
+    }
+
+    /**
+     * \brief pause or resume recording. Does nothing if no output was requested on the command line.
+     */
+    void toggle_recording() {
+        if ( !_recorder ) {
+            return;
+        }
+        if ( _recording ) {
+            _readback->flush(*_recorder);
+        }
+        _recording = !_recording;
+    }
+
+    /**
+     * \brief stop recording, wait for every captured frame to be written and report the frame counts
+     */
+    void finish_recording() {
+        if ( !_recorder ) {
+            return;
+        }
+        _readback->flush(*_recorder);
+        _recording = false;
+        _recorder->flush();
+        ofLogNotice("recorder") << "wrote " << _recorder->written() << " frames to " << _output_path << ", dropped "
+                                << _recorder->dropped() << ", failed " << _recorder->failed();
+    }
+
+  private:
+    /**
+     * \brief buffers, texture and mesh for one resolution level
+     */
+    struct level_resources {
+        std::size_t width;
+        std::size_t height;
+        ofPixels front;  //!< frame that is uploaded and displayed
+        ofPixels back;   //!< frame the engine is filling
+        ofTexture texture;
+        ofPlanePrimitive plane;
+    };
+
+    /**
+     * \brief allocate the buffers, texture and mesh for a resolution level
+     *
+     * \param width field width in pixels
+     * \param height field height in pixels
+     * \param scale fraction of the full resolution, which also scales a fixed mesh density
+     */
+    void allocate_level(std::size_t width, std::size_t height, float scale) {
+        auto& level = _levels.emplace_back();
+        level.width = width;
+        level.height = height;
+        level.front.allocate(width, height, OF_PIXELS_GRAY);
+        level.back.allocate(width, height, OF_PIXELS_GRAY);
+        std::fill(level.front.getData(), level.front.getData() + level.front.size(), 0);
+        level.texture.allocate(level.front);
+        level.plane.set(_settings.plane_width,
+                        _settings.plane_height,
+                        (_settings.mesh_columns > 0) ? std::max(static_cast<int>(_settings.mesh_columns * scale + 0.5f), 2) : static_cast<int>(width),
+                        (_settings.mesh_rows > 0) ? std::max(static_cast<int>(_settings.mesh_rows * scale + 0.5f), 2) : static_cast<int>(height),
+                        OF_PRIMITIVE_TRIANGLES);
+        level.plane.mapTexCoordsFromTexture(level.texture);
+    }
+
+    /**
+     * \brief switch to another resolution level. The engine is resized and refilled straight away so the next update
+     *        presents a frame at the new size.
+     *
+     * \param index the level
+     */
+    void set_level(std::size_t index) {
+        wait_idle();
+        auto& level = _levels[index];
+        _engine.resize(level.width, level.height);
+        _level = index;
+        _engine.fill(level.back.getData());
+        _shown_checksum = frame_checksum(level.back.getData(), level.back.size());
+        _job_changed = true;
+        ofLogNotice("heightfield") << "resolution " << level.width << "x" << level.height << " (average frame "
+                                   << _resolution->average_ms() << " ms)";
+    }
+
+    /**
+     * \brief advance the engine and fill the back buffer if the output changed
+     *
+     * \param time_sec simulation time
+     * \retval true if the back buffer holds a new frame that differs from the one on screen
+     */
+    bool simulate(double time_sec) {
+        bool changed = false;
+        {
+            frame_profiler::scope timer{_profiler, stage_simulate};
+            changed = _engine.update(time_sec);
+        }
+        if ( !changed ) {
+            return false;
+        }
+        auto& back = _levels[_level].back;
+        {
+            frame_profiler::scope timer{_profiler, stage_fill};
+            _engine.fill(back.getData());
+        }
+        const auto checksum = frame_checksum(back.getData(), back.size());
+        if ( checksum == _shown_checksum ) {
+            return false;
+        }
+        _shown_checksum = checksum;
+        return true;
+    }
+
+    /**
+     * \brief swap in and upload a newly simulated frame
+     */
+    void present() {
+        if ( _job_changed ) {
+            _job_changed = false;
+            auto& level = _levels[_level];
+            level.front.swap(level.back);
+            frame_profiler::scope timer{_profiler, stage_upload};
+            level.texture.loadData(level.front);
+        }
+    }
+
+    /**
+     * \brief block until the worker has finished its current job
+     */
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _signal.wait(lock, [this]() { return !_job_pending; });
+    }
+
+    /**
+     * \brief worker thread that simulates one frame each time a job is submitted
+     */
+    void worker_loop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while ( true ) {
+            _signal.wait(lock, [this]() { return _job_pending || _stopping; });
+            if ( _stopping ) {
+                return;
+            }
+            const auto time_sec = _job_time;
+            lock.unlock();
+            const auto changed = simulate(time_sec);
+            lock.lock();
+            _job_changed = changed;
+            _job_pending = false;
+            _signal.notify_all();
+        }
+    }
+
+    Engine _engine;
+    heightfield_settings _settings;
+    frame_profiler _profiler;
+    ofShader _displacement_shader;
+    glm::mat4 _plane_to_clip;  //!< projection * model view of the plane when it was last drawn
+    ofRectangle _viewport;
+
+    //!< resolution levels, finest first. Only the first exists without a frame time target.
+    std::vector<level_resources> _levels;
+    std::size_t _level;
+    std::optional<resolution_controller> _resolution;
+    std::chrono::steady_clock::time_point _frame_start;
+    uint64_t _shown_checksum = 0;  //!< checksum of the newest frame handed over for display
+
+    //!< recording state
+    std::unique_ptr<frame_recorder> _recorder;
+    std::unique_ptr<async_readback> _readback;
+    std::string _output_path;
+    bool _recording;
+
+    //!< worker state
+    bool _threaded;
+    std::thread _worker;
+    std::mutex _mutex;
+    std::condition_variable _signal;
+    double _job_time = 0;
+    bool _job_pending;
+    bool _job_changed;
+    bool _stopping;
+};
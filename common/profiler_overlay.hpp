@@ -0,0 +1,53 @@
+/**
+ * \file profiler_overlay.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief open frameworks overlay that draws frame profiler percentiles on top of a sketch
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "frame_profiler.hpp"
+#include "ofMain.h"
+#include <cstdio>
+#include <string>
+
+/********************************** Functions *******************************************/
+/**
+ * \brief draw a table of per-stage percentiles in the top left of the window
+ *
+ * \param profiler the profiler to summarize
+ */
+inline void draw_profiler_overlay(const frame_profiler& profiler) {
+    const auto statistics = profiler.summarize(profiler.snapshot());
+    std::string text = "stage            p50 ms   p90 ms   p99 ms   max ms\n";
+    char line[128];
+    for ( std::size_t stage = 0; stage < statistics.size(); stage++ ) {
+        const auto& s = statistics[stage];
+        std::snprintf(line, sizeof(line), "%-14s %8.3f %8.3f %8.3f %8.3f\n", profiler.stage_names()[stage], s.p50_ms, s.p90_ms, s.p99_ms, s.max_ms);
+        text += line;
+    }
+    std::snprintf(line, sizeof(line), "fps %.1f", ofGetFrameRate());
+    text += line;
+    ofDrawBitmapStringHighlight(text, 20, 30);
+}
+
+/**
+ * \brief dump the profiler ring buffer to <prefix>.csv and <prefix>.trace.json if anything was recorded
+ *
+ * \param profiler the profiler to dump
+ * \param prefix output path prefix
+ */
+inline void dump_profiler(const frame_profiler& profiler, const std::string& prefix) {
+    if ( profiler.snapshot().empty() ) {
+        return;
+    }
+    profiler.write_csv(prefix + ".csv");
+    profiler.write_chrome_trace(prefix + ".trace.json");
+    ofLogNotice("profiler") << "wrote " << prefix << ".csv and " << prefix << ".trace.json";
+}
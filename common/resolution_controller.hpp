@@ -0,0 +1,120 @@
+/**
+ * \file resolution_controller.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief picks a simulation resolution level from measured frame times to hold a frame time target
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief tuning for the resolution controller
+ */
+struct resolution_settings {
+    double target_ms = 16.0;         //!< frame time to hold
+    double smoothing = 0.1;          //!< weight of each new frame in the moving average
+    double downscale_margin = 1.15;  //!< drop a level once the average is above target * margin
+    double upscale_margin = 0.8;     //!< raise a level once the predicted time at that level is below target * margin
+    uint32_t settle_frames = 30;     //!< frames a condition must hold before the level changes
+    uint32_t cooldown_frames = 90;   //!< frames after a change before the next one is considered
+};
+
+/**
+ * \brief resolution controller with hysteresis. Levels are ordered from finest (0) to coarsest and each has a relative
+ *        cost, e.g. its pixel count. A level is only dropped after the average frame time has been over target for a run
+ *        of frames, and only raised when the average scaled by the cost ratio predicts the finer level will still fit under
+ *        the target. The gap between the two margins and a cooldown after each change stop the level from flapping.
+ */
+class resolution_controller {
+  public:
+    /**
+     * \brief Construct a new resolution controller object
+     *
+     * \param level_costs relative cost of each level from finest to coarsest
+     * \param initial_level level to start at
+     * \param settings tuning
+     */
+    resolution_controller(std::vector<double> level_costs, std::size_t initial_level, const resolution_settings& settings)
+        : _costs(std::move(level_costs))
+        , _settings(settings)
+        , _level(std::min(initial_level, _costs.empty() ? 0 : _costs.size() - 1))
+        , _average_ms(0)
+        , _frames(0)
+        , _over(0)
+        , _under(0)
+        , _cooldown(settings.cooldown_frames) { }
+
+    /**
+     * \brief record the time of a frame and decide whether the level should change
+     *
+     * \param frame_ms measured frame time in milliseconds
+     * \retval std::optional<std::size_t> the new level, or nothing to stay at the current one
+     */
+    std::optional<std::size_t> record(double frame_ms) {
+        _average_ms = (_frames++ == 0) ? frame_ms : _average_ms + _settings.smoothing * (frame_ms - _average_ms);
+        if ( _cooldown > 0 ) {
+            _cooldown--;
+            return std::nullopt;
+        }
+
+        const bool over = _average_ms > _settings.target_ms * _settings.downscale_margin;
+        const bool under = (_level > 0) &&
+                           (_average_ms * _costs[_level - 1] / _costs[_level] < _settings.target_ms * _settings.upscale_margin);
+        _over = over ? _over + 1 : 0;
+        _under = under ? _under + 1 : 0;
+
+        if ( (_over >= _settings.settle_frames) && (_level + 1 < _costs.size()) ) {
+            return change_level(_level + 1);
+        }
+        if ( _under >= _settings.settle_frames ) {
+            return change_level(_level - 1);
+        }
+        return std::nullopt;
+    }
+
+    std::size_t level() const {
+        return _level;
+    }
+
+    double average_ms() const {
+        return _average_ms;
+    }
+
+  private:
+    /**
+     * \brief switch level and rescale the average by the cost ratio as a first guess of the frame time at the new level
+     *
+     * \param level the new level
+     * \retval std::size_t the new level
+     */
+    std::size_t change_level(std::size_t level) {
+        _average_ms *= _costs[level] / _costs[_level];
+        _level = level;
+        _over = 0;
+        _under = 0;
+        _cooldown = _settings.cooldown_frames;
+        return level;
+    }
+
+    std::vector<double> _costs;
+    resolution_settings _settings;
+    std::size_t _level;
+    double _average_ms;
+    uint64_t _frames;
+    uint32_t _over;
+    uint32_t _under;
+    uint32_t _cooldown;
+};
@@ -0,0 +1,104 @@
+/**
+ * \file simulation_clock.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief time source for the sketch simulations that can either follow the wall clock or advance
+ *        in fixed steps for deterministic, repeatable runs
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <chrono>
+#include <cstdint>
+
+/********************************** Types *******************************************/
+/**
+ * \brief simulation clock. In realtime mode each tick samples a monotonic clock, in fixed step mode
+ *        each tick advances the simulation time by exactly one step regardless of how long the frame took.
+ */
+class simulation_clock {
+  public:
+    /**
+     * \brief factory method for a clock that follows the wall clock
+     *
+     * \retval simulation_clock
+     */
+    static simulation_clock realtime() {
+        return simulation_clock{0.0};
+    }
+
+    /**
+     * \brief factory method for a clock that advances a fixed amount of simulation time per tick
+     *
+     * \param step_sec simulation time per tick in seconds
+     * \retval simulation_clock
+     */
+    static simulation_clock fixed_step(double step_sec) {
+        return simulation_clock{step_sec};
+    }
+
+    /**
+     * \brief advance the clock by one frame
+     *
+     * \retval double the simulation time for the new frame in seconds
+     */
+    double tick() {
+        if ( is_fixed_step() ) {
+            //!< multiply rather than accumulate so long runs don't drift
+            _time_sec = static_cast<double>(_ticks) * _step_sec;
+        } else {
+            _time_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        }
+        _ticks++;
+        return _time_sec;
+    }
+
+    /**
+     * \brief get the simulation time of the current frame without advancing the clock
+     *
+     * \retval double time in seconds
+     */
+    double seconds() const {
+        return _time_sec;
+    }
+
+    /**
+     * \brief get the number of ticks since the clock started
+     *
+     * \retval uint64_t tick count
+     */
+    uint64_t ticks() const {
+        return _ticks;
+    }
+
+    /**
+     * \brief check if the clock is running in fixed step mode
+     *
+     * \retval true if fixed step
+     */
+    bool is_fixed_step() const {
+        return _step_sec > 0.0;
+    }
+
+  private:
+    /**
+     * \brief Construct a new simulation clock object
+     *
+     * \param step_sec the step size, or zero for realtime
+     */
+    explicit simulation_clock(double step_sec)
+        : _step_sec(step_sec)
+        , _time_sec(0.0)
+        , _ticks(0)
+        , _start(std::chrono::steady_clock::now()) { }
+
+    double _step_sec;
+    double _time_sec;
+    uint64_t _ticks;
+    std::chrono::steady_clock::time_point _start;
+};
@@ -0,0 +1,118 @@
+/**
+ * \file sketch_options.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief command line options shared by the open frameworks sketches
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "simulation_clock.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+/********************************** Types *******************************************/
+/**
+ * \brief output format for frames written in headless mode
+ */
+enum class frame_format : unsigned { none = 0, pgm, raw, y4m, png };
+
+/**
+ * \brief options for running a sketch
+ */
+struct sketch_options {
+    bool headless = false;                   //!< run the simulation without creating a window
+    uint64_t frames = 600;                   //!< number of frames to simulate in headless mode
+    double time_step_sec = 0.0;              //!< fixed simulation step. Zero follows the wall clock in windowed mode
+    std::string output_path;                 //!< directory (pgm, png) or file (raw, y4m) to write frames to
+    frame_format format = frame_format::none;
+    bool profile = false;                    //!< start with per-stage frame profiling enabled
+    bool threaded = true;                    //!< simulate the next frame on a worker thread while the current one is drawn
+    double target_frame_ms = 0.0;            //!< adapt the field resolution to hold this update and draw time. Zero disables it.
+    uint32_t seed = 1;                       //!< seed for random initial state in headless mode, so runs are repeatable
+
+    /**
+     * \brief create the simulation clock described by the options. Headless runs are always fixed step
+     *        so that they are repeatable.
+     *
+     * \retval simulation_clock
+     */
+    simulation_clock make_clock() const {
+        if ( time_step_sec > 0.0 ) {
+            return simulation_clock::fixed_step(time_step_sec);
+        }
+        return headless ? simulation_clock::fixed_step(1.0 / 60.0) : simulation_clock::realtime();
+    }
+
+    /**
+     * \brief frame rate to write into recorded video streams
+     *
+     * \retval unsigned frames per second
+     */
+    unsigned record_fps() const {
+        return (time_step_sec > 0.0) ? static_cast<unsigned>(1.0 / time_step_sec + 0.5) : 60;
+    }
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief parse the sketch options from the command line. Unknown arguments are ignored so that
+ *        individual sketches can layer their own flags on top.
+ *
+ *        --headless          run without a window
+ *        --frames <n>        number of frames to run in headless mode
+ *        --step <seconds>    fixed simulation time step
+ *        --pgm <directory>   write each frame as a numbered PGM file
+ *        --raw <file>        write all frames back to back into one raw 8-bit file
+ *        --y4m <file>        write all frames into one Y4M video stream
+ *        --png <directory>   write each frame as a numbered PNG file
+ *        --profile           start with the frame profiler and overlay enabled
+ *        --no-threads        simulate on the render thread
+ *        --target-ms <ms>    lower the field resolution when update and draw take longer than this
+ *        --seed <n>          seed for random initial state in headless mode (default 1)
+ *
+ * \param argc number of CLI arguments
+ * \param argv list of arguments
+ * \retval sketch_options
+ */
+inline sketch_options parse_sketch_options(int argc, char* argv[]) {
+    sketch_options options;
+    for ( int i = 1; i < argc; i++ ) {
+        const std::string argument{argv[i]};
+        const bool has_value = (i + 1) < argc;
+        if ( argument == "--headless" ) {
+            options.headless = true;
+        } else if ( argument == "--frames" && has_value ) {
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        } else if ( argument == "--step" && has_value ) {
+            options.time_step_sec = std::strtod(argv[++i], nullptr);
+        } else if ( argument == "--pgm" && has_value ) {
+            options.format = frame_format::pgm;
+            options.output_path = argv[++i];
+        } else if ( argument == "--raw" && has_value ) {
+            options.format = frame_format::raw;
+            options.output_path = argv[++i];
+        } else if ( argument == "--y4m" && has_value ) {
+            options.format = frame_format::y4m;
+            options.output_path = argv[++i];
+        } else if ( argument == "--png" && has_value ) {
+            options.format = frame_format::png;
+            options.output_path = argv[++i];
+        } else if ( argument == "--profile" ) {
+            options.profile = true;
+        } else if ( argument == "--no-threads" ) {
+            options.threaded = false;
+        } else if ( argument == "--target-ms" && has_value ) {
+            options.target_frame_ms = std::strtod(argv[++i], nullptr);
+        } else if ( argument == "--seed" && has_value ) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+    return options;
+}
@@ -0,0 +1,140 @@
+/**
+ * \file worker_pool.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief persistent pool of worker threads that split a range of rows into bands. The threads are created once and reused
+ *        for every call so that per-frame (or per-step) work doesn't pay for thread creation.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief fork/join pool for row bands. The calling thread runs the first band itself, so a pool of one thread runs
+ *        everything inline.
+ */
+class worker_pool {
+  public:
+    using band_job = std::function<void(std::size_t first_row, std::size_t last_row)>;
+
+    /**
+     * \brief Construct a new worker pool object
+     *
+     * \param threads total number of threads including the caller. Zero uses the hardware concurrency.
+     */
+    explicit worker_pool(unsigned threads = 0)
+        : _threads(std::max(1u, (threads > 0) ? threads : std::thread::hardware_concurrency()))
+        , _generation(0)
+        , _remaining(0)
+        , _rows(0)
+        , _stopping(false) {
+        for ( unsigned band = 1; band < _threads; band++ ) {
+            _workers.emplace_back([this, band]() { worker_loop(band); });
+        }
+    }
+
+    ~worker_pool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _start.notify_all();
+        for ( auto& worker : _workers ) {
+            worker.join();
+        }
+    }
+
+    worker_pool(const worker_pool&) = delete;
+    worker_pool& operator=(const worker_pool&) = delete;
+
+    /**
+     * \brief split rows [0, rows) into one contiguous band per thread and block until every band has run
+     *
+     * \param rows number of rows
+     * \param job function called with the [first, last) rows of each band
+     */
+    void for_each_band(std::size_t rows, const band_job& job) {
+        if ( (_threads == 1) || (rows < _threads) ) {
+            job(0, rows);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            _rows = rows;
+            _remaining = _threads - 1;
+            _generation++;
+        }
+        _start.notify_all();
+
+        run_band(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _remaining == 0; });
+        _job = nullptr;
+    }
+
+    unsigned threads() const {
+        return _threads;
+    }
+
+  private:
+    /**
+     * \brief run one band of the current job
+     *
+     * \param band band index
+     */
+    void run_band(unsigned band) {
+        const auto first = _rows * band / _threads;
+        const auto last = _rows * (band + 1) / _threads;
+        (*_job)(first, last);
+    }
+
+    /**
+     * \brief worker thread that runs its band each time a job is started
+     *
+     * \param band the band this thread owns
+     */
+    void worker_loop(unsigned band) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while ( true ) {
+            _start.wait(lock, [this, seen]() { return _stopping || (_generation != seen); });
+            if ( _stopping ) {
+                return;
+            }
+            seen = _generation;
+            lock.unlock();
+            run_band(band);
+            lock.lock();
+            if ( --_remaining == 0 ) {
+                _done.notify_one();
+            }
+        }
+    }
+
+    unsigned _threads;
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const band_job* _job = nullptr;
+    uint64_t _generation;
+    unsigned _remaining;
+    std::size_t _rows;
+    bool _stopping;
+};
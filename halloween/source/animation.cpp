@@ -9,8 +9,11 @@
 
 #include "animation.hpp"
 #include "bitmap_image.hpp"
+#include <iostream>
 #include <thread>
 
+#define SCROLL_RATE_MS (70)  //!< time per pixel shift of scrolling text, which is also the frame period
+
 animation::animation(graphics::frame& frame, fonts::font& font)
     : m_frame(frame)
     , m_font(font) {}
@@ -41,8 +44,16 @@ void animation::display_image(const std::string& path, uint32_t time_ms) {
 void animation::scroll_text(const std::string& message) {
     m_frame.clear();
     auto chars = m_font.encode_with_default(message, ' ');
-    auto scroller = graphics::scrolling_font_renderer{chars, 70, graphics::origin{0, 9}, {255, 50, 0} };
+    auto layout = graphics::text_layout{m_font, chars};
+    auto scroller = graphics::scrolling_font_renderer{layout, SCROLL_RATE_MS, graphics::origin{0, 9}, {255, 50, 0} };
+
+    //!< sleep between frames so the refresh thread gets the CPU, the scroller positions the text from the wake up time
+    graphics::frame_scheduler scheduler{std::chrono::milliseconds(SCROLL_RATE_MS)};
+    scroller.draw(m_frame);
     while (!scroller.message_completed()) {
-        scroller.draw(m_frame);
+        scroller.draw(m_frame, scheduler.wait());
+    }
+    if ( scheduler.missed_deadlines() > 0 ) {
+        scheduler.report(std::cerr, "scroll_text \"" + message + "\"");
     }
 }
@@ -92,6 +92,23 @@ configuration_options::configuration_options(const configuration_options& other)
 }
 
 
+/**
+ * \brief Construct a new configuration options object by move
+ * 
+ * \param other the other to move from
+ */
+configuration_options::configuration_options(configuration_options&& other) noexcept
+    : options(other.options)
+    , runtime_options(other.runtime_options)
+    , string_options(std::move(other.string_options))
+    , app_options(std::move(other.app_options)) {
+    options.hardware_mapping = string_options.hardware_mapping.c_str();
+    options.panel_type = string_options.panel_type.c_str();
+    options.led_rgb_sequence = string_options.led_rgb_sequence.c_str();
+    options.pixel_mapper_config = string_options.pixel_mapper_config.c_str();
+}
+
+
 /**
  * \brief parse configuration options from JSON into matrix options struct. Returns an RGB matrix object if the
  *        options are valid.
@@ -208,9 +225,9 @@ expected<configuration_options, std::string> create_options_from_json(json& conf
 
     std::string validation_results;
     if ( options.options.Validate(&validation_results) ) {
-        return expected<configuration_options, std::string>::success(options);
+        return expected<configuration_options, std::string>::success(std::move(options));
     } else {
-        return expected<configuration_options, std::string>::error(validation_results);
+        return expected<configuration_options, std::string>::error(std::move(validation_results));
     }
 }
 
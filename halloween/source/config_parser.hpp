@@ -57,6 +57,14 @@ struct configuration_options {
      * \param other the other to copy from
      */
     configuration_options(const configuration_options& other);
+
+    /**
+     * \brief Construct a new Configuration Options object by move, which also resets the string
+     *        pointers since short strings move their characters
+     * 
+     * \param other the other to move from
+     */
+    configuration_options(configuration_options&& other) noexcept;
 };
 
 /********************************** Function Declarations *******************************************/
@@ -0,0 +1,59 @@
+/**
+ * \file embedded_font.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief glyph tables of a BDF font compiled into the binary
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "character.hpp"
+#include "font.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace fonts
+{
+/********************************** Types *******************************************/
+/**
+ * \brief constexpr glyph tables of a font, in the same layout fonts::font uses at runtime. These are generated from the
+ *        BDF files listed in EMBEDDED_FONTS by tools/font_cache/bdf_to_header into embedded_fonts.hpp, so the font is in
+ *        read only data and loading it neither parses nor allocates.
+ *
+ * \tparam Width glyph width if every glyph fills the font bounding box, otherwise 0
+ * \tparam Height glyph height if every glyph fills the font bounding box, otherwise 0
+ * \tparam TableSize entries in the encoding table
+ * \tparam GlyphCount number of glyphs
+ * \tparam Rows number of bitmap rows
+ */
+template <int Width, int Height, std::size_t TableSize, std::size_t GlyphCount, std::size_t Rows>
+struct embedded_font {
+    static constexpr int width = Width;    //!< glyph width, for graphics::fixed_size_font_renderer
+    static constexpr int height = Height;  //!< glyph height, for graphics::fixed_size_font_renderer
+
+    uint16_t first_encoding;                                  //!< encoding of the first entry in the table
+    bounding_box box;                                         //!< FONTBOUNDINGBOX of the font
+    int ascent;                                               //!< FONT_ASCENT of the font
+    std::array<uint16_t, TableSize> table;                    //!< glyph index of each encoding, 0xFFFF if there is none
+    std::array<character_properties, GlyphCount> properties;  //!< properties of each glyph
+    std::array<uint32_t, GlyphCount> bitmap_offsets;          //!< first row of each glyph in the bitmaps
+    std::array<uint32_t, Rows> bitmaps;                       //!< rows of every glyph back to back
+
+    /**
+     * \brief get a font that reads these tables in place
+     *
+     * \retval font
+     */
+    font load() const {
+        const font::glyph_storage storage{table.data(), table.size(), properties.data(), bitmap_offsets.data(), bitmaps.data(), GlyphCount, Rows};
+        return font::from_storage(storage, first_encoding, box, ascent);
+    }
+};
+
+};  // namespace fonts
@@ -1,8 +1,12 @@
-/*! \file expected.hpps
+/*! \file expected.hpp
 *
 *  \brief expected algebraic data type for error handling. This essentially an either type
 *         or an expanded optional that returns either the type, or a custom error type.
 *
+*         The value or error is constructed in place by the factory methods and is only ever moved
+*         when the expected is an rvalue, so chains of and_then/map/or_else on a temporary never
+*         copy the payload. Move only types are supported, but moves must not throw so that
+*         assignment can never leave the expected without a live value or error.
 *
 *  \author Graham Riches
 */
@@ -12,218 +16,458 @@
 #include <optional>
 #include <utility>
 #include <exception>
+#include <stdexcept>
 #include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 
 /********************************** Types *******************************************/
+template <typename T, typename E>
+class expected;
+
+namespace detail
+{
+template <typename T>
+struct is_expected : std::false_type { };
+
+template <typename T, typename E>
+struct is_expected<expected<T, E>> : std::true_type { };
+};  // namespace detail
+
 /**
  * \brief class template for an expected type. This either contains a T with the _valid result
  *        of the computation, or an E, which is any custom error type
- * 
+ *
  * \tparam T type of the expected in the success case
  * \tparam E type of the expected in the error case
  */
 template <typename T, typename E>
-class expected {
+class [[nodiscard]] expected {
   private:
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>,
+                  "expected requires value and error types that can be moved without throwing");
+
+    struct value_tag { };  //!< selects the in place value constructor
+    struct error_tag { };  //!< selects the in place error constructor
+
     union {
         T _value;
         E _error;
     };
     bool _valid;
 
+    /**
+     * \brief Construct the value in place
+     *
+     * \param params arguments forwarded to the constructor of T
+     */
+    template <typename... Args>
+    explicit expected(value_tag, Args&&... params)
+        : _value(std::forward<Args>(params)...)
+        , _valid(true) { }
+
+    /**
+     * \brief Construct the error in place
+     *
+     * \param params arguments forwarded to the constructor of E
+     */
+    template <typename... Args>
+    explicit expected(error_tag, Args&&... params)
+        : _error(std::forward<Args>(params)...)
+        , _valid(false) { }
+
+    /**
+     * \brief destroy whichever member of the union is active
+     */
+    void destroy() noexcept {
+        if ( _valid ) {
+            _value.~T();
+        } else {
+            _error.~E();
+        }
+    }
+
+    /**
+     * \brief construct the active member from another expected, copying or moving depending on the
+     *        value category of other
+     *
+     * \param other the expected to construct from
+     */
+    template <typename Other>
+    void construct_from(Other&& other) {
+        if ( other._valid ) {
+            new (std::addressof(_value)) T(std::forward<Other>(other)._value);
+        } else {
+            new (std::addressof(_error)) E(std::forward<Other>(other)._error);
+        }
+        _valid = other._valid;
+    }
+
+    /**
+     * \brief throw when an accessor is called on the wrong state. Marked noreturn so the accessors stay
+     *        small enough to inline.
+     *
+     * \param message what the exception should say
+     */
+    [[noreturn]] static void bad_access(const char* message) {
+        throw std::logic_error(message);
+    }
+
+    template <typename Self, typename F>
+    static auto and_then_impl(Self&& self, F&& f) {
+        using R = std::invoke_result_t<F, decltype((std::forward<Self>(self)._value))>;
+        static_assert(detail::is_expected<std::decay_t<R>>::value, "and_then must return an expected");
+        if ( self._valid ) {
+            return std::invoke(std::forward<F>(f), std::forward<Self>(self)._value);
+        }
+        return std::decay_t<R>::error(std::forward<Self>(self)._error);
+    }
+
+    template <typename Self, typename F>
+    static auto map_impl(Self&& self, F&& f) {
+        using U = std::decay_t<std::invoke_result_t<F, decltype((std::forward<Self>(self)._value))>>;
+        using R = expected<U, E>;
+        if ( self._valid ) {
+            return R::success(std::invoke(std::forward<F>(f), std::forward<Self>(self)._value));
+        }
+        return R::error(std::forward<Self>(self)._error);
+    }
+
+    template <typename Self, typename F>
+    static auto or_else_impl(Self&& self, F&& f) {
+        using R = std::invoke_result_t<F, decltype((std::forward<Self>(self)._error))>;
+        static_assert(detail::is_expected<std::decay_t<R>>::value, "or_else must return an expected");
+        if ( self._valid ) {
+            return std::decay_t<R>::success(std::forward<Self>(self)._value);
+        }
+        return std::invoke(std::forward<F>(f), std::forward<Self>(self)._error);
+    }
+
+    template <typename, typename>
+    friend class expected;
+
   public:
+    using value_type = T;
+    using error_type = E;
+
     /**
      * \brief factory method to create an expected from the success type
-     * 
+     *
      * \tparam Args parameter pack of arguments
      * \param params arguments parameter pack
-     * \retval expected 
+     * \retval expected
      */
     template <typename... Args>
     static expected success(Args&&... params) {
-        expected result;
-        result._valid = true;
-        new (&result._value) T(std::forward<Args>(params)...);
-        return result;
+        return expected{value_tag{}, std::forward<Args>(params)...};
     }
 
     /**
      * \brief factory method to create an expected from the error type
-     * 
+     *
      * \tparam Args parameter pack of arguments
      * \param params the pack of arguments
-     * \retval expected 
+     * \retval expected
      */
     template <typename... Args>
     static expected error(Args&&... params) {
-        expected result;
-        result._valid = false;
-        new (&result._error) E(std::forward<Args>(params)...);
-        return result;
-    }    
+        return expected{error_tag{}, std::forward<Args>(params)...};
+    }
 
     /**
      * \brief get the expected value out of the variant
      * \note user should check if the value is valid before trying to access it
-     * 
+     *
      * \retval T& returns a T if it exists, otherwise throws an exception
      */
-    const T& get_value() const {
-        if (_valid) {
-            return _value;
-        } else {
-            throw std::logic_error("Expected does not contain a valid value type");
+    const T& get_value() const& {
+        if ( !_valid ) {
+            bad_access("Expected does not contain a valid value type");
         }
+        return _value;
     }
 
     /**
      * \brief get the expected value out of the variant
      * \note user should check if the value is valid before trying to access it
-     * 
+     *
      * \retval T& returns a T if it exists, otherwise throws an exception
      */
-    T& get_value() {
-        if (_valid) {
-            return _value;
-        } else {
-            throw std::logic_error("Expected does not contain a valid value type");
+    T& get_value() & {
+        if ( !_valid ) {
+            bad_access("Expected does not contain a valid value type");
         }
+        return _value;
     }
 
+    /**
+     * \brief get the expected value out of an expiring expected so it can be moved from
+     * \note user should check if the value is valid before trying to access it
+     *
+     * \retval T&& returns a T if it exists, otherwise throws an exception
+     */
+    T&& get_value() && {
+        if ( !_valid ) {
+            bad_access("Expected does not contain a valid value type");
+        }
+        return std::move(_value);
+    }
 
     /**
      * \brief Get the error value out of the union.
      * \note user should check that it is indeed an error before trying to retrieve it
-     * 
+     *
      * \retval E& the error value if it exists, otherwise an exception
      */
-    const E& get_error() const {
-        if (_valid) {
-            throw std::logic_error("Expected does not contain an error type");
-        } else {
-            return _error;
+    const E& get_error() const& {
+        if ( _valid ) {
+            bad_access("Expected does not contain an error type");
         }
+        return _error;
     }
 
     /**
      * \brief Get the error value out of the union.
      * \note user should check that it is indeed an error before trying to retrieve it
-     * 
+     *
      * \retval E& the error value if it exists, otherwise an exception
      */
-    E& get_error() {
-        if (_valid) {
-            throw std::logic_error("Expected does not contain an error type");
-        } else {
-            return _error;
+    E& get_error() & {
+        if ( _valid ) {
+            bad_access("Expected does not contain an error type");
         }
+        return _error;
+    }
+
+    /**
+     * \brief Get the error value out of an expiring expected so it can be moved from
+     * \note user should check that it is indeed an error before trying to retrieve it
+     *
+     * \retval E&& the error value if it exists, otherwise an exception
+     */
+    E&& get_error() && {
+        if ( _valid ) {
+            bad_access("Expected does not contain an error type");
+        }
+        return std::move(_error);
+    }
+
+    /**
+     * \brief checked access that does not throw
+     *
+     * \retval T* pointer to the value, or nullptr if the expected holds an error
+     */
+    T* value_if() noexcept {
+        return _valid ? std::addressof(_value) : nullptr;
+    }
+
+    /**
+     * \brief checked access that does not throw
+     *
+     * \retval const T* pointer to the value, or nullptr if the expected holds an error
+     */
+    const T* value_if() const noexcept {
+        return _valid ? std::addressof(_value) : nullptr;
+    }
+
+    /**
+     * \brief checked access to the error that does not throw
+     *
+     * \retval E* pointer to the error, or nullptr if the expected holds a value
+     */
+    E* error_if() noexcept {
+        return _valid ? nullptr : std::addressof(_error);
+    }
+
+    /**
+     * \brief checked access to the error that does not throw
+     *
+     * \retval const E* pointer to the error, or nullptr if the expected holds a value
+     */
+    const E* error_if() const noexcept {
+        return _valid ? nullptr : std::addressof(_error);
+    }
+
+    /**
+     * \brief get the value or a fallback if the expected holds an error
+     *
+     * \param fallback value returned in the error case
+     * \retval T copy of the value or the fallback
+     */
+    template <typename U>
+    T get_value_or(U&& fallback) const& {
+        return _valid ? _value : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /**
+     * \brief get the value or a fallback if the expected holds an error, moving the value out
+     *
+     * \param fallback value returned in the error case
+     * \retval T the value or the fallback
+     */
+    template <typename U>
+    T get_value_or(U&& fallback) && {
+        return _valid ? std::move(_value) : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /**
+     * \brief check if the expected contains a value
+     *
+     * \retval true if the expected contains type T and not E
+     */
+    bool has_value() const noexcept {
+        return _valid;
+    }
+
+    /**
+     * \brief chain another operation that can fail on the value. The error is passed through unchanged.
+     *
+     * \param f callable taking the value and returning an expected with the same error type
+     * \retval the result of f, or the error
+     */
+    template <typename F>
+    auto and_then(F&& f) & {
+        return and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto and_then(F&& f) const& {
+        return and_then_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto and_then(F&& f) && {
+        return and_then_impl(std::move(*this), std::forward<F>(f));
     }
 
     /**
-     * \brief Construct a new expected object with the default constructor
+     * \brief transform the value with an operation that can not fail. The error is passed through unchanged.
+     *
+     * \param f callable taking the value
+     * \retval expected of the result of f, or the error
      */
-    expected() {};
+    template <typename F>
+    auto map(F&& f) & {
+        return map_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto map(F&& f) const& {
+        return map_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto map(F&& f) && {
+        return map_impl(std::move(*this), std::forward<F>(f));
+    }
+
+    /**
+     * \brief recover from an error. The value is passed through unchanged.
+     *
+     * \param f callable taking the error and returning an expected with the same value type
+     * \retval the value, or the result of f
+     */
+    template <typename F>
+    auto or_else(F&& f) & {
+        return or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto or_else(F&& f) const& {
+        return or_else_impl(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto or_else(F&& f) && {
+        return or_else_impl(std::move(*this), std::forward<F>(f));
+    }
 
     /**
      * \brief Construct a new expected object from a copy
-     * 
+     *
      * \param other the other to copy from
      */
-    expected(const expected& other)
-        : _valid(other._valid) {
-        if ( _valid ) {
-            new (&_value) T(other._value);
-        } else {
-            new (&_error) E(other._error);
-        }
+    expected(const expected& other) {
+        construct_from(other);
     }
 
     /**
      * \brief Construct a new expected object from a move
-     * 
-     * \param other the other to mvoe
+     *
+     * \param other the other to move
      */
-    expected(expected&& other)
-        : _valid(other._valid) {
-        if ( _valid ) {
-            new (&_value) T(std::move(other._value));
-        } else {
-            new (&_error) E(std::move(other._error));
-        }
+    expected(expected&& other) noexcept {
+        construct_from(std::move(other));
     }
 
     /**
-     * \brief copy assignment operator uses the exception safe swap idiom
-     * 
+     * \brief copy assignment operator. The copy is made before this is modified so a throwing copy
+     *        leaves this unchanged.
+     *
      * \param other other expected to assign to this
-     * \retval expected& 
+     * \retval expected&
      */
-    expected& operator=(expected other) {
-        swap(other);
+    expected& operator=(const expected& other) {
+        if ( this != &other ) {
+            expected copy{other};
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * \brief move assignment operator
+     *
+     * \param other other expected to move into this
+     * \retval expected&
+     */
+    expected& operator=(expected&& other) noexcept {
+        if ( this != &other ) {
+            destroy();
+            construct_from(std::move(other));
+        }
         return *this;
     }
 
     /**
      * \brief casting operator to bool so that expected types can directly be used in control flow
-     * 
+     *
      * \retval returns true if the expected contains type T and not E
      */
-    operator bool() const {
+    operator bool() const noexcept {
         return _valid;
     }
 
     /**
-     * \brief Destroy the expected object based on the contained type in the union    
+     * \brief Destroy the expected object based on the contained type in the union
      */
     ~expected() {
-        if ( _valid ) {
-            _value.~T();
-        } else {
-            _error.~E();
-        }
+        destroy();
     }
 
     /**
-     * \brief helper function that implements the swap idiom for exception safety during the assignment
-     *        operator
-     * 
-     * \param other the other expected to assign to this
+     * \brief swap the contents of two expected objects
+     *
+     * \param other the other expected to swap with
      */
-    void swap(expected& other) {
-        if ( _valid ) {
-            if ( other._valid ) {
-                std::swap(_value, other._value);
-            } else {
-                auto temp_error = std::move(other._error);
-                other._error.~E();
-                new (&other._value) T(std::move(_value));
-                _value.~T();
-                new (&_error) E(std::move(temp_error));
-                std::swap(_valid, other._valid);
-            }
-        } else {
-            if ( other._valid ) {
-                other.swap(*this);
-            } else {
-                std::swap(_error, other._error);
-            }
-        }
+    void swap(expected& other) noexcept {
+        expected temp{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(temp);
     }
 };
 
 /**
- * \brief monad bind for the expected type that allows chaining of multiple expected operations together
+ * \brief monad bind for the expected type that allows chaining of multiple expected operations together.
+ *        The value and error are moved through when exp is an rvalue.
  *
  * \param exp expected type
  * \param f function to bind with
  * \retval R result or an error
  */
-template <typename T, typename E, typename F, typename R = decltype(std::declval<F>()(std::declval<T>()))>
-R mbind(const expected<T, E>& exp, F f) {
-    if (exp) {
-        return std::invoke(f, exp.get_value());
-    } else {
-        return R::error(exp.get_error());
-    }
-}
\ No newline at end of file
+template <typename Expected, typename F, typename = std::enable_if_t<detail::is_expected<std::decay_t<Expected>>::value>>
+auto mbind(Expected&& exp, F&& f) {
+    return std::forward<Expected>(exp).and_then(std::forward<F>(f));
+}
@@ -11,57 +11,446 @@
 
 /********************************** Includes *******************************************/
 #include "font.hpp"
-#include "range/v3/all.hpp"
-#include "string_utilities.hpp"
-#include <fstream>
-#include <iostream>
-#include <sstream>
-#include <string>
-#include <charconv>
+#include "mapped_file.hpp"
 #include <algorithm>
-#include <exception>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 
 
 /********************************** Constants *******************************************/
 #define INTEGER_HEX_BASE (16ul)
+#define MAX_ROW_HEX_DIGITS (8)  //!< hex digits of a bitmap row that fit in a uint32_t. Wider glyphs keep their leftmost 32 pixels.
+#define MAX_GLYPH_ROWS (127)    //!< largest BBX height
+#define GLYPH_PAGE_SIZE (256)   //!< encodings in each page of decoded glyphs of a lazily loaded font
+#define ROW_BLOCK_SIZE (1024)   //!< bitmap rows in each block of the row arena of a lazily loaded font
+#define REPLACEMENT_CHARACTER (0xFFFDu)  //!< code point invalid UTF-8 decodes to
 
 namespace fonts
 {
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief splits a buffer into lines without copying and counts them for error messages
+ */
+struct line_reader {
+    std::string_view buffer;
+    std::size_t position;
+    std::size_t line_number;
+
+    /**
+     * \brief get the next line without its line ending
+     * 
+     * \param line the line
+     * \retval true if there was another line
+     */
+    bool next(std::string_view& line) {
+        if ( position >= buffer.size() ) {
+            return false;
+        }
+        const auto end = std::min(buffer.find('\n', position), buffer.size());
+        line = buffer.substr(position, end - position);
+        if ( !line.empty() && (line.back() == '\r') ) {
+            line.remove_suffix(1);
+        }
+        position = end + 1;
+        line_number++;
+        return true;
+    }
+
+    /**
+     * \brief build an error message for the current line
+     * 
+     * \param message what went wrong
+     * \retval std::string message prefixed with the line number
+     */
+    std::string error(const std::string& message) const {
+        return "line " + std::to_string(line_number) + ": " + message;
+    }
+};
+
+
+/**
+ * \brief get the keyword at the start of a BDF line
+ * 
+ * \param line the line
+ * \retval std::string_view 
+ */
+static std::string_view keyword(std::string_view line) {
+    return line.substr(0, line.find(' '));
+}
+
+
+/**
+ * \brief parse the integers that follow the keyword of a line
+ * 
+ * \param line the line
+ * \param values parsed values
+ * \retval true if there were at least N integers
+ */
+template <std::size_t N>
+static bool parse_values(std::string_view line, std::array<int, N>& values) {
+    auto position = keyword(line).size();
+    for ( auto& value : values ) {
+        while ( (position < line.size()) && (line[position] == ' ') ) {
+            position++;
+        }
+        const auto [end, error] = std::from_chars(line.data() + position, line.data() + line.size(), value);
+        if ( error != std::errc{} ) {
+            return false;
+        }
+        position = end - line.data();
+    }
+    return true;
+}
+
+
+/**
+ * \brief parse a row of a glyph bitmap
+ * 
+ * \param line the line of hex digits
+ * \param row the parsed row
+ * \retval true if the line was valid hex
+ */
+static bool parse_row(std::string_view line, uint32_t& row) {
+    const auto digits = std::min<std::size_t>(line.size(), MAX_ROW_HEX_DIGITS);
+    if ( (digits == 0) || !std::all_of(line.begin(), line.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; }) ) {
+        return false;
+    }
+    return std::from_chars(line.data(), line.data() + digits, row, INTEGER_HEX_BASE).ec == std::errc{};
+}
+
+
+/**
+ * \brief properties of the font from the lines before the first glyph
+ */
+struct font_header {
+    std::optional<bounding_box> box;  //!< FONTBOUNDINGBOX
+    int ascent;                       //!< FONT_ASCENT
+    int glyph_count;                  //!< CHARS
+};
+
+
+/**
+ * \brief parse the font header. On success the line is the first STARTCHAR line, or the last line if there are no glyphs.
+ * 
+ * \param reader reader at the start of the font
+ * \param line the last line read
+ * \retval expected<font_header, std::string> 
+ */
+static expected<font_header, std::string> parse_header(line_reader& reader, std::string_view& line) {
+    using result = expected<font_header, std::string>;
+    font_header header{std::nullopt, 0, 0};
+    while ( reader.next(line) ) {
+        const auto key = keyword(line);
+        if ( key == "FONTBOUNDINGBOX" ) {
+            std::array<int, 4> box;
+            if ( !parse_values(line, box) ) {
+                return result::error(reader.error("FONTBOUNDINGBOX needs four integers"));
+            }
+            header.box.emplace(box[0], box[1], box[2], box[3]);
+        } else if ( key == "FONT_ASCENT" ) {
+            std::array<int, 1> ascent;
+            if ( !parse_values(line, ascent) ) {
+                return result::error(reader.error("FONT_ASCENT needs an integer"));
+            }
+            header.ascent = ascent[0];
+        } else if ( key == "CHARS" ) {
+            std::array<int, 1> count;
+            if ( parse_values(line, count) && (count[0] > 0) ) {
+                header.glyph_count = count[0];
+            }
+        } else if ( key == "STARTCHAR" ) {
+            break;
+        }
+    }
+    return result::success(std::move(header));
+}
+
+
 /**
- * \brief Construct a new font object from a vector of characters
+ * \brief a glyph record from STARTCHAR to ENDCHAR, without its bitmap
+ */
+struct glyph_record {
+    int encoding;                         //!< ENCODING, which may be out of the range of a uint16_t
+    std::array<int, 2> scalable_width;    //!< SWIDTH
+    std::array<int, 2> device_width;      //!< DWIDTH, or the BBX width if the glyph has none
+    std::array<int, 4> box;               //!< BBX
+
+    /**
+     * \brief check if the glyph has an encoding that can be looked up
+     */
+    bool has_encoding() const {
+        return (encoding >= 0) && (encoding <= UINT16_MAX);
+    }
+
+    /**
+     * \brief get the properties of the glyph
+     * 
+     * \retval character_properties 
+     */
+    character_properties properties() const {
+        return character_properties(static_cast<uint16_t>(encoding),
+                                    std::make_pair<uint16_t, uint16_t>(scalable_width[0], scalable_width[1]),
+                                    std::make_pair<uint8_t, uint8_t>(device_width[0], device_width[1]),
+                                    bounding_box(box[0], box[1], box[2], box[3]));
+    }
+};
+
+
+/**
+ * \brief parse a glyph record. The line must be its STARTCHAR line, and on success it is the ENDCHAR line.
  * 
- * \param characters vector of character objects
+ * \param reader reader positioned after the STARTCHAR line
+ * \param line the last line read
+ * \param add_row called with each bitmap row, after the encoding and size of the glyph are known
+ * \retval expected<glyph_record, std::string> 
+ */
+template <typename RowSink>
+static expected<glyph_record, std::string> parse_glyph(line_reader& reader, std::string_view& line, RowSink&& add_row) {
+    using result = expected<glyph_record, std::string>;
+    const auto start_line = reader.line_number;
+    std::optional<int> encoding;
+    std::array<int, 2> scalable_width{0, 0};
+    std::optional<std::array<int, 2>> device_width;
+    std::optional<std::array<int, 4>> box;
+    while ( reader.next(line) ) {
+        const auto key = keyword(line);
+        if ( key == "ENCODING" ) {
+            std::array<int, 1> value;
+            if ( !parse_values(line, value) ) {
+                return result::error(reader.error("ENCODING needs an integer"));
+            }
+            encoding = value[0];
+        } else if ( key == "SWIDTH" ) {
+            if ( !parse_values(line, scalable_width) ) {
+                return result::error(reader.error("SWIDTH needs two integers"));
+            }
+        } else if ( key == "DWIDTH" ) {
+            device_width.emplace();
+            if ( !parse_values(line, *device_width) ) {
+                return result::error(reader.error("DWIDTH needs two integers"));
+            }
+        } else if ( key == "BBX" ) {
+            box.emplace();
+            if ( !parse_values(line, *box) || ((*box)[0] < 0) || ((*box)[0] > INT8_MAX) || ((*box)[1] < 0) || ((*box)[1] > MAX_GLYPH_ROWS) ) {
+                return result::error(reader.error("BBX needs four integers and a size from 0 to 127"));
+            }
+        } else if ( key == "BITMAP" ) {
+            if ( !encoding || !box ) {
+                return result::error(reader.error("BITMAP before ENCODING and BBX of the glyph started on line " + std::to_string(start_line)));
+            }
+            for ( int row = 0; row < (*box)[1]; row++ ) {
+                uint32_t bits;
+                if ( !reader.next(line) || !parse_row(line, bits) ) {
+                    return result::error(reader.error("expected " + std::to_string((*box)[1]) + " bitmap rows"));
+                }
+                add_row(*encoding, bits);
+            }
+            if ( !reader.next(line) || (line != "ENDCHAR") ) {
+                return result::error(reader.error("expected ENDCHAR after the bitmap rows"));
+            }
+            return result::success(glyph_record{*encoding, scalable_width, device_width.value_or(std::array<int, 2>{(*box)[0], 0}), *box});
+        } else if ( (key == "ENDCHAR") || (key == "STARTCHAR") || (key == "ENDFONT") ) {
+            return result::error(reader.error("glyph started on line " + std::to_string(start_line) + " has no BITMAP"));
+        }
+    }
+    return result::error(reader.error("glyph started on line " + std::to_string(start_line) + " is not terminated"));
+}
+
+
+/**
+ * \brief decode the next code point of a UTF-8 string. Invalid, overlong and truncated sequences and surrogates decode to
+ *        U+FFFD and skip a single byte, so the rest of the string still decodes.
+ * 
+ * \param text the string
+ * \param position index of the first byte of the code point, moved past it
+ * \retval uint32_t the code point
+ */
+static uint32_t next_code_point(const std::string& text, std::size_t& position) {
+    const auto lead = static_cast<unsigned char>(text[position]);
+    if ( lead < 0x80 ) {
+        position++;
+        return lead;
+    }
+    const int length = ((lead & 0xE0) == 0xC0) ? 2 : ((lead & 0xF0) == 0xE0) ? 3 : ((lead & 0xF8) == 0xF0) ? 4 : 0;
+    if ( (length == 0) || (position + length > text.size()) ) {
+        position++;
+        return REPLACEMENT_CHARACTER;
+    }
+    uint32_t code_point = lead & (0x7F >> length);
+    for ( int i = 1; i < length; i++ ) {
+        const auto continuation = static_cast<unsigned char>(text[position + i]);
+        if ( (continuation & 0xC0) != 0x80 ) {
+            position++;
+            return REPLACEMENT_CHARACTER;
+        }
+        code_point = (code_point << 6) | (continuation & 0x3F);
+    }
+    constexpr uint32_t smallest[] = {0, 0, 0x80, 0x800, 0x10000};
+    if ( (code_point < smallest[length]) || (code_point > 0x10FFFF) || ((code_point >= 0xD800) && (code_point <= 0xDFFF)) ) {
+        position++;
+        return REPLACEMENT_CHARACTER;
+    }
+    position += length;
+    return code_point;
+}
+
+
+/**
+ * \brief glyphs of a font loaded with from_file_lazy. The mapped BDF file is only indexed up front, and each glyph is parsed
+ *        the first time it is looked up into pages that never move, so glyph views stay valid for the life of the font.
+ */
+struct font::lazy_glyphs {
+    //!< decode state of each encoding in a page
+    enum class slot_state : uint8_t { unknown = 0, present, missing };
+
+    struct slot {
+        glyph value;
+        slot_state state;
+    };
+
+    using page = std::array<slot, GLYPH_PAGE_SIZE>;
+
+    mapped_file file;                                                    //!< the BDF file
+    std::vector<std::pair<uint16_t, uint32_t>> records;                  //!< encoding and byte offset of each glyph record, sorted by encoding
+    std::array<std::unique_ptr<page>, (UINT16_MAX + 1) / GLYPH_PAGE_SIZE> pages;  //!< decode state of each encoding, allocated on first use
+    std::deque<character_properties> properties;                         //!< properties of the decoded glyphs
+    std::vector<std::unique_ptr<uint32_t[]>> row_blocks;                 //!< bitmap rows of the decoded glyphs
+    std::size_t rows_used;                                               //!< rows used in the last row block
+    std::mutex lock;                                                     //!< guards the decode state, which lookups fill in
+
+    explicit lazy_glyphs(mapped_file&& file)
+        : file(std::move(file))
+        , rows_used(0) { }
+
+    /**
+     * \brief get a glyph, parsing it on first use
+     * 
+     * \param encoding the encoding of the glyph
+     * \retval std::optional<glyph> the glyph, or nothing if the font does not have it or its record is malformed
+     */
+    std::optional<glyph> get(uint16_t encoding) {
+        const auto record = std::lower_bound(records.begin(), records.end(), encoding, [](const auto& entry, uint16_t value) {
+            return entry.first < value;
+        });
+        if ( (record == records.end()) || (record->first != encoding) ) {
+            return std::nullopt;
+        }
+        std::lock_guard<std::mutex> guard{lock};
+        auto& current_page = pages[encoding / GLYPH_PAGE_SIZE];
+        if ( !current_page ) {
+            current_page = std::make_unique<page>();
+        }
+        auto& entry = (*current_page)[encoding % GLYPH_PAGE_SIZE];
+        if ( entry.state == slot_state::unknown ) {
+            entry = decode(record->second);
+        }
+        return (entry.state == slot_state::present) ? std::optional<glyph>{entry.value} : std::nullopt;
+    }
+
+    /**
+     * \brief parse the glyph record at an offset of the file
+     * 
+     * \param offset byte offset of the STARTCHAR line
+     * \retval slot the decoded glyph
+     */
+    slot decode(uint32_t offset) {
+        line_reader reader{file.view(), offset, 0};
+        std::string_view line;
+        std::array<uint32_t, MAX_GLYPH_ROWS> rows;
+        std::size_t row_count = 0;
+        reader.next(line);
+        const auto maybe_record = parse_glyph(reader, line, [&](int, uint32_t row) {
+            rows[row_count++] = row;
+        });
+        if ( !maybe_record ) {
+            return slot{glyph{nullptr, nullptr}, slot_state::missing};
+        }
+        if ( row_blocks.empty() || (rows_used + row_count > ROW_BLOCK_SIZE) ) {
+            row_blocks.push_back(std::make_unique<uint32_t[]>(ROW_BLOCK_SIZE));
+            rows_used = 0;
+        }
+        auto* bitmap = row_blocks.back().get() + rows_used;
+        std::copy(rows.begin(), rows.begin() + row_count, bitmap);
+        rows_used += row_count;
+        properties.push_back(maybe_record.get_value().properties());
+        return slot{glyph{&properties.back(), bitmap}, slot_state::present};
+    }
+};
+
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct an empty font for the parser to fill
+ */
+font::font()
+    : _first_encoding(0)
+    , _ascent(0)
+    , _external{} { }
+
+
+/**
+ * \brief size the encoding table to span the glyphs in the font and fill it. The first glyph with an encoding wins.
  */
-font::font(const std::vector<character>& characters) {
-    for (const auto& character : characters) {
-        _characters.insert(std::make_pair(character.properties.encoding, character));
+void font::build_table() {
+    _table.clear();
+    if ( _properties.empty() ) {
+        return;
+    }
+    const auto [lowest, highest] = std::minmax_element(_properties.begin(), _properties.end(), [](const auto& a, const auto& b) {
+        return a.encoding < b.encoding;
+    });
+    _first_encoding = lowest->encoding;
+    _table.assign(highest->encoding - _first_encoding + 1, missing_glyph);
+    for ( std::size_t index = 0; (index < _properties.size()) && (index < missing_glyph); index++ ) {
+        auto& entry = _table[_properties[index].encoding - _first_encoding];
+        if ( entry == missing_glyph ) {
+            entry = static_cast<uint16_t>(index);
+        }
     }
 }
 
 
 /**
- * \brief Get a character by its encoding value
+ * \brief Get a glyph by its encoding value. Does not throw, and only allocates when a lazily loaded glyph is first used.
  * 
- * \param encoding the ASCII encoding of the character
- * \retval expected<character, std::string> maybe character
+ * \param encoding the encoding of the character
+ * \retval std::optional<glyph> view of the glyph, or nothing if the font does not have it
  */
-expected<character, std::string> font::get_character(const uint16_t encoding) {
-    try {
-        return expected<character, std::string>::success(_characters.at(encoding));
-    } catch (...) {
-        return expected<character, std::string>::error("Could not find character encoding");
+std::optional<glyph> font::get_glyph(const uint16_t encoding) const noexcept {
+    if ( _lazy ) {
+        try {
+            return _lazy->get(encoding);
+        } catch ( const std::exception& ) {
+            return std::nullopt;
+        }
+    }
+    const auto glyphs = storage();
+    if ( (encoding < _first_encoding) || (static_cast<std::size_t>(encoding - _first_encoding) >= glyphs.table_size) ) {
+        return std::nullopt;
     }
+    const auto index = glyphs.table[encoding - _first_encoding];
+    if ( index == missing_glyph ) {
+        return std::nullopt;
+    }
+    return glyph{&glyphs.properties[index], glyphs.bitmaps + glyphs.bitmap_offsets[index]};
 }
 
 
 /**
- * \brief Get a character from its char equivalent encoding
+ * \brief Get a glyph from its char equivalent encoding
  * 
  * \param encoding the char equivalent encoding
- * \retval expected<character, std::string> maybe character
+ * \retval std::optional<glyph> view of the glyph, or nothing if the font does not have it
  */
-expected<character, std::string> font::get_character(const char encoding) {
-    return this->get_character(static_cast<uint16_t>(encoding));
+std::optional<glyph> font::get_glyph(const char encoding) const noexcept {
+    return get_glyph(static_cast<uint16_t>(static_cast<unsigned char>(encoding)));
 }
 
 
@@ -72,24 +461,8 @@ expected<character, std::string> font::get_character(const char encoding) {
  * \retval excpected<font, std::string> 
  */
 expected<font, std::string> font::from_stream(std::istream&& stream) {
-    //!< read the input stream into a string buffer and get read the underlying string
-    std::stringstream buffer;
-    buffer << stream.rdbuf();
-    std::string font_data = buffer.str();
-
-    //!< split the string by properties and characters
-    auto temp = string_helpers::split(font_data, "ENDPROPERTIES\n");    
-    auto character_strings = string_helpers::split(temp[1], "ENDCHAR\n");    
-    
-    //!< apply some range based transformations and parsing
-    auto characters = character_strings | ranges::views::transform([](auto&& c){ return character::from_string(c); })
-                                        | ranges::views::filter([](auto&& exp){ return (exp) ? true : false; })
-                                        | ranges::views::transform([](auto&& exp){return exp.get_value();})
-                                        | ranges::to_vector;
-
-    //!< return either the parsed font or an error
-    return (characters.size() > 0) ? expected<fonts::font, std::string>::success(font(characters))
-         : expected<fonts::font, std::string>::error("No characters found for font");    
+    const std::string font_data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    return from_buffer(font_data);
 }
 
 /**
@@ -104,34 +477,180 @@ expected<font, std::string> font::from_stream(std::istream& stream) {
 
 
 /**
- * \brief encode a string as a vector of bitmapped characters
+ * \brief factory method to memory map a BDF file and parse it in place
+ * 
+ * \param path path of the BDF file
+ * \retval expected<font, std::string> 
+ */
+expected<font, std::string> font::from_file(const std::string& path) {
+    auto file = mapped_file::open(path);
+    if ( !file ) {
+        return expected<font, std::string>::error("could not open " + path);
+    }
+    file->advise_sequential();
+    return from_buffer(file->view());
+}
+
+
+/**
+ * \brief factory method to memory map a BDF file and index its glyph records without parsing them
+ * 
+ * \param path path of the BDF file
+ * \retval expected<font, std::string> 
+ */
+expected<font, std::string> font::from_file_lazy(const std::string& path) {
+    using result = expected<font, std::string>;
+    auto file = mapped_file::open(path);
+    if ( !file ) {
+        return result::error("could not open " + path);
+    }
+    const auto buffer = file->view();
+    line_reader reader{buffer, 0, 0};
+    std::string_view line;
+    auto maybe_header = parse_header(reader, line);
+    if ( !maybe_header ) {
+        return result::error(maybe_header.get_error());
+    }
+
+    font indexed;
+    indexed._bounding_box = maybe_header.get_value().box;
+    indexed._ascent = maybe_header.get_value().ascent;
+    auto glyphs = std::make_shared<lazy_glyphs>(std::move(*file));
+    glyphs->records.reserve(maybe_header.get_value().glyph_count);
+
+    //!< only find the start and the ENCODING line of each record, the rest is parsed on first use
+    auto start = (keyword(line) == "STARTCHAR") ? static_cast<std::size_t>(line.data() - buffer.data()) : std::string_view::npos;
+    while ( start != std::string_view::npos ) {
+        const auto next = buffer.find("\nSTARTCHAR", start);
+        const auto encoding_line = buffer.find("\nENCODING", start);
+        if ( encoding_line < next ) {
+            const auto line_start = encoding_line + 1;
+            const auto line_end = std::min(buffer.find('\n', line_start), buffer.size());
+            std::array<int, 1> encoding;
+            if ( parse_values(buffer.substr(line_start, line_end - line_start), encoding) && (encoding[0] >= 0) && (encoding[0] <= UINT16_MAX) ) {
+                glyphs->records.emplace_back(static_cast<uint16_t>(encoding[0]), static_cast<uint32_t>(start));
+            }
+        }
+        start = (next == std::string_view::npos) ? next : next + 1;
+    }
+    if ( glyphs->records.empty() ) {
+        return result::error("No characters found for font");
+    }
+
+    //!< the first record of an encoding wins, like build_table
+    std::stable_sort(glyphs->records.begin(), glyphs->records.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    indexed._lazy = std::move(glyphs);
+    return result::success(std::move(indexed));
+}
+
+
+/**
+ * \brief factory method to use glyph storage owned by someone else
+ * 
+ * \param storage the glyph storage, which must outlive the font
+ * \param first_encoding encoding of the first table entry
+ * \param box FONTBOUNDINGBOX of the font if it has one
+ * \param ascent FONT_ASCENT of the font
+ * \retval font 
+ */
+font font::from_storage(const glyph_storage& storage, uint16_t first_encoding, std::optional<bounding_box> box, int ascent) {
+    font external_font;
+    external_font._first_encoding = first_encoding;
+    external_font._bounding_box = box;
+    external_font._ascent = ascent;
+    external_font._external = storage;
+    return external_font;
+}
+
+
+/**
+ * \brief factory method to parse BDF data in a single pass. Glyphs with no encoding (ENCODING -1) are skipped.
+ * 
+ * \param buffer the BDF file contents
+ * \retval expected<font, std::string> 
+ */
+expected<font, std::string> font::from_buffer(std::string_view buffer) {
+    using result = expected<font, std::string>;
+    font parsed;
+    line_reader reader{buffer, 0, 0};
+    std::string_view line;
+
+    //!< font header, up to the first glyph
+    auto maybe_header = parse_header(reader, line);
+    if ( !maybe_header ) {
+        return result::error(maybe_header.get_error());
+    }
+    const auto& header = maybe_header.get_value();
+    parsed._bounding_box = header.box;
+    parsed._ascent = header.ascent;
+    parsed._properties.reserve(header.glyph_count);
+    parsed._bitmap_offsets.reserve(header.glyph_count);
+
+    //!< glyphs: each runs from STARTCHAR to ENDCHAR with its rows after BITMAP
+    while ( keyword(line) == "STARTCHAR" ) {
+        //!< glyphs without an encoding are parsed for errors but not kept
+        const auto offset = parsed._bitmaps.size();
+        const auto maybe_record = parse_glyph(reader, line, [&](int encoding, uint32_t row) {
+            if ( (encoding >= 0) && (encoding <= UINT16_MAX) ) {
+                parsed._bitmaps.push_back(row);
+            }
+        });
+        if ( !maybe_record ) {
+            return result::error(maybe_record.get_error());
+        }
+        if ( maybe_record.get_value().has_encoding() ) {
+            parsed._properties.push_back(maybe_record.get_value().properties());
+            parsed._bitmap_offsets.push_back(static_cast<uint32_t>(offset));
+        }
+
+        //!< skip to the next glyph or the end of the font
+        while ( reader.next(line) && (keyword(line) != "STARTCHAR") && (keyword(line) != "ENDFONT") ) { }
+    }
+
+    if ( parsed._properties.empty() ) {
+        return result::error("No characters found for font");
+    }
+    parsed.build_table();
+    return result::success(std::move(parsed));
+}
+
+
+/**
+ * \brief encode a string as a vector of glyph views
  * 
  * \param message the message string
- * \retval maybe of vector of characters or error
+ * \retval maybe of vector of glyphs or error
  */
-expected<std::vector<character>, std::string> font::encode(const std::string& message) {
-    auto characters = message | ranges::views::transform([this](auto&& c){return get_character(c);})
-                              | ranges::views::filter([](auto&& exp){return (exp) ? true : false;})
-                              | ranges::views::transform([](auto&& exp){return exp.get_value();})
-                              | ranges::to_vector;
-    
-    return (characters.size() != message.size()) ? expected<std::vector<character>, std::string>::error("Encoding one or more tokens failed")
-         : expected<std::vector<character>, std::string>::success(characters);
+expected<std::vector<glyph>, std::string> font::encode(const std::string& message) const {
+    std::vector<glyph> glyphs;
+    glyphs.reserve(message.size());
+    for ( std::size_t position = 0; position < message.size(); ) {
+        auto maybe_glyph = get_code_point(next_code_point(message, position));
+        if ( !maybe_glyph ) {
+            return expected<std::vector<glyph>, std::string>::error("Encoding one or more tokens failed");
+        }
+        glyphs.push_back(*maybe_glyph);
+    }
+    return expected<std::vector<glyph>, std::string>::success(std::move(glyphs));
 }
 
 
 /**
- * \brief lookup a string and encode it as character objects. Replace any failed lookups with a default character
+ * \brief lookup a string and encode it as glyph views. Replace any failed lookups with a default glyph
  * 
  * \param message the message to encode
- * \param default_character the default character to replace any failed lookups with
- * \retval std::vector<font::character> 
+ * \param default_glyph the default glyph to replace any failed lookups with
+ * \retval std::vector<glyph> 
  */
-std::vector<character> font::encode_with_default(const std::string& message, const character default_character) {
-    /* perform the lookup, swap any invalid expected types with the default and return as a vector */
-    return message | ranges::views::transform([this](auto&& c){return get_character(c);})
-                   | ranges::views::transform([this, default_character](auto&& exp){ return (exp) ? exp.get_value() : default_character; })
-                   | ranges::to_vector;
+std::vector<glyph> font::encode_with_default(const std::string& message, const glyph default_glyph) const {
+    std::vector<glyph> glyphs;
+    glyphs.reserve(message.size());
+    for ( std::size_t position = 0; position < message.size(); ) {
+        glyphs.push_back(get_code_point(next_code_point(message, position)).value_or(default_glyph));
+    }
+    return glyphs;
 }
 
 
@@ -142,32 +661,89 @@ std::vector<character> font::encode_with_default(const std::string& message, con
  * 
  * \param message the string to encode
  * \param default_character default character to replace missing characters with
- * \retval std::vector<character> 
- */
-std::vector<character> font::encode_with_default(const std::string& message, const char default_character) {
-    auto maybe_character = get_character(default_character);
-    if (maybe_character) {
-        auto character = maybe_character.get_value();
-        return encode_with_default(message, character);
-    } else {
+ * \retval std::vector<glyph> 
+ */
+std::vector<glyph> font::encode_with_default(const std::string& message, const char default_character) const {
+    auto maybe_glyph = get_glyph(default_character);
+    if ( !maybe_glyph ) {
         throw std::runtime_error("default character does not exist in the selected font");
     }
+    return encode_with_default(message, *maybe_glyph);
 }
 
 
 /**
- * \brief Get the bbox object for the font
+ * \brief Get the bbox object for the font. This is the FONTBOUNDINGBOX, or the box of 'a' if the font has none.
  * 
  * \retval optional<bounding_box> 
  */
-std::optional<bounding_box> font::get_bbox() {
-    auto maybe_character_a = get_character('a');
-    if (maybe_character_a) {
-        auto character_a = maybe_character_a.get_value();
-        return character_a.properties.b_box;
-    } else {
-        return {};
+std::optional<bounding_box> font::get_bbox() const {
+    if ( _bounding_box ) {
+        return _bounding_box;
+    }
+    auto maybe_glyph = get_glyph('a');
+    if ( maybe_glyph ) {
+        return maybe_glyph->properties->b_box;
+    }
+    return {};
+}
+
+
+
+/**
+ * \brief get the number of pixels from the baseline to the top of the font, from FONT_ASCENT
+ * 
+ * \retval int 
+ */
+int font::ascent() const {
+    return _ascent;
+}
+
+
+/**
+ * \brief get the number of glyphs in the font
+ * 
+ * \retval std::size_t 
+ */
+std::size_t font::size() const {
+    return _lazy ? _lazy->records.size() : storage().glyph_count;
+}
+
+
+/**
+ * \brief get the glyph of a unicode code point
+ * 
+ * \param code_point the code point
+ * \retval std::optional<glyph> the glyph, or nothing if the font does not have it or it is beyond 16-bit encodings
+ */
+std::optional<glyph> font::get_code_point(uint32_t code_point) const noexcept {
+    if ( code_point > UINT16_MAX ) {
+        return std::nullopt;
+    }
+    return get_glyph(static_cast<uint16_t>(code_point));
+}
+
+
+/**
+ * \brief get the encoding of the first entry in the glyph table
+ * 
+ * \retval uint16_t 
+ */
+uint16_t font::first_encoding() const {
+    return _first_encoding;
+}
+
+
+/**
+ * \brief get pointers to the glyph storage in use
+ * 
+ * \retval glyph_storage the mapped cache or embedded tables if the font uses them, otherwise the font's own vectors
+ */
+font::glyph_storage font::storage() const {
+    if ( _external.table != nullptr ) {
+        return _external;
     }
+    return glyph_storage{_table.data(), _table.size(), _properties.data(), _bitmap_offsets.data(), _bitmaps.data(), _properties.size(), _bitmaps.size()};
 }
 
 };  // namespace fonts
@@ -14,10 +14,14 @@
 /********************************** Includes *******************************************/
 #include "expected.hpp"
 #include "character.hpp"
+#include "mapped_file.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <istream>
-#include <map>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <optional>
@@ -27,16 +31,23 @@ namespace fonts
 /**
  * \brief font object that contains the character encoding for each ascii character in it's binary
  *        encoded equivalent. This provides functions to transform char and string inputs into pixel
- *        mappings.
+ *        mappings. Glyphs are stored densely: a table indexed by encoding holds the index of each glyph,
+ *        and the bitmaps of all glyphs share one contiguous arena.
  */
 class font {
   public:
     /**
-     * \brief Construct a new font object from a vector of characters
-     * 
-     * \param characters vector of character objects
+     * \brief pointers to the glyph storage of a font: its own vectors, a mapped cache file or tables compiled into the binary
      */
-    font(const std::vector<character>& characters);
+    struct glyph_storage {
+        const uint16_t* table;                   //!< glyph index of each encoding from the first encoding on
+        std::size_t table_size;                  //!< entries in the table
+        const character_properties* properties;  //!< properties of each glyph
+        const uint32_t* bitmap_offsets;          //!< first row of each glyph in the bitmaps
+        const uint32_t* bitmaps;                 //!< rows of every glyph back to back
+        std::size_t glyph_count;                 //!< number of glyphs
+        std::size_t bitmap_rows;                 //!< number of bitmap rows
+    };
 
     /**
      * \brief factory method to parse a stream of data that is stored as a stream
@@ -55,37 +66,99 @@ class font {
     static expected<font, std::string> from_stream(std::istream&& stream);
 
     /**
-     * \brief Get a character by its encoding value
+     * \brief factory method to parse BDF data in a single pass. Glyph rows are written straight into the font's storage,
+     *        and errors carry the line number they were found on.
+     * 
+     * \param buffer the BDF file contents
+     * \retval expected<font, std::string> 
+     */
+    static expected<font, std::string> from_buffer(std::string_view buffer);
+
+    /**
+     * \brief factory method to memory map a BDF file and parse it in place
+     * 
+     * \param path path of the BDF file
+     * \retval expected<font, std::string> 
+     */
+    static expected<font, std::string> from_file(const std::string& path);
+
+    /**
+     * \brief factory method to memory map a BDF file and only index where each glyph record starts. A glyph is parsed the
+     *        first time it is looked up, so the load time and memory depend on the glyphs that are used rather than on the
+     *        size of the font. Malformed glyphs are not reported here: they are missing when they are looked up. Copies of
+     *        the font share the index and the decoded glyphs.
+     * 
+     * \param path path of the BDF file
+     * \retval expected<font, std::string> 
+     */
+    static expected<font, std::string> from_file_lazy(const std::string& path);
+
+    /**
+     * \brief factory method to memory map a binary font cache built by tools/font_cache and use it in place, with no
+     *        parsing and no per glyph allocation. Falls back to parsing the BDF source when the cache is missing, corrupt,
+     *        from another version or layout, or was built from a different source file. The cache is trusted as is when
+     *        the source file is not there.
+     * 
+     * \param cache_path path of the font cache
+     * \param source_path path of the BDF file the cache was built from
+     * \retval expected<font, std::string> 
+     */
+    static expected<font, std::string> from_cache(const std::string& cache_path, const std::string& source_path);
+
+    /**
+     * \brief factory method to use glyph storage owned by someone else, such as the tables of an embedded font. Nothing is
+     *        copied, so the storage must outlive the font and every copy of it.
+     * 
+     * \param storage the glyph storage
+     * \param first_encoding encoding of the first table entry
+     * \param box FONTBOUNDINGBOX of the font if it has one
+     * \param ascent FONT_ASCENT of the font
+     * \retval font 
+     */
+    static font from_storage(const glyph_storage& storage, uint16_t first_encoding, std::optional<bounding_box> box, int ascent);
+
+    /**
+     * \brief write the font in the binary font cache format
+     * 
+     * \param output binary stream to write to
+     * \param source_checksum font_cache_checksum of the BDF file the font was parsed from
+     * \param source_size size of the BDF file
+     * \retval true if the whole cache was written
+     */
+    bool write_cache(std::ostream& output, uint64_t source_checksum, uint64_t source_size) const;
+
+    /**
+     * \brief Get a glyph by its encoding value. Does not throw, and only allocates when a lazily loaded glyph is first used.
      * 
-     * \param encoding the ASCII encoding of the character
-     * \retval expected<character, std::string> maybe character
+     * \param encoding the encoding of the character
+     * \retval std::optional<glyph> view of the glyph, or nothing if the font does not have it
      */
-    expected<character, std::string> get_character(const uint16_t encoding);
+    std::optional<glyph> get_glyph(const uint16_t encoding) const noexcept;
 
     /**
-     * \brief Get a character from its char equivalent encoding
+     * \brief Get a glyph from its char equivalent encoding
      * 
      * \param encoding the char equivalent encoding
-     * \retval expected<character, std::string> maybe character
+     * \retval std::optional<glyph> view of the glyph, or nothing if the font does not have it
      */
-    expected<character, std::string> get_character(const char encoding);
+    std::optional<glyph> get_glyph(const char encoding) const noexcept;
 
     /**
-     * \brief encode a string as a vector of bitmapped characters
+     * \brief encode a UTF-8 string as a vector of glyph views, one per code point. Invalid UTF-8 decodes to U+FFFD.
      * 
      * \param message the message string
-     * \retval maybe of vector of characters or error
+     * \retval maybe of vector of glyphs or error
      */
-    expected<std::vector<character>, std::string> encode(const std::string& message);
+    expected<std::vector<glyph>, std::string> encode(const std::string& message) const;
 
     /**
-     * \brief lookup a string and encode it as character objects. Replace any failed lookups with a default character
+     * \brief lookup a UTF-8 string and encode it as glyph views. Replace any failed lookups with a default glyph
      * 
      * \param message the message to encode
-     * \param default_character the default character to replace any failed lookups with
-     * \retval std::vector<font::character> 
+     * \param default_glyph the default glyph to replace any failed lookups with
+     * \retval std::vector<glyph> 
      */
-    std::vector<character> encode_with_default(const std::string& message, const character default_character);
+    std::vector<glyph> encode_with_default(const std::string& message, const glyph default_glyph) const;
 
     /**
      * \brief lookup a string and replace any missing characters with the character passed as default provided it exists
@@ -94,18 +167,64 @@ class font {
      * 
      * \param message the string to encode
      * \param default_character default character to replace missing characters with
-     * \retval std::vector<character> 
+     * \retval std::vector<glyph> 
      */
-    std::vector<character> encode_with_default(const std::string& message, const char default_character);
+    std::vector<glyph> encode_with_default(const std::string& message, const char default_character) const;
 
     /**
-     * \brief Get the bbox object for the font
+     * \brief Get the bbox object for the font. This is the FONTBOUNDINGBOX, or the box of 'a' if the font has none.
      * 
      * \retval optional<bounding_box> 
      */
-    std::optional<bounding_box> get_bbox();
+    std::optional<bounding_box> get_bbox() const;
+
+    /**
+     * \brief get the number of pixels from the baseline to the top of the font, from FONT_ASCENT
+     * 
+     * \retval int 
+     */
+    int ascent() const;
+
+    /**
+     * \brief get the number of glyphs in the font
+     * 
+     * \retval std::size_t 
+     */
+    std::size_t size() const;
+
+    /**
+     * \brief get the encoding of the first entry in the glyph table
+     * 
+     * \retval uint16_t 
+     */
+    uint16_t first_encoding() const;
+
+    /**
+     * \brief get pointers to the glyph storage in use. Fonts from from_file_lazy have no contiguous storage, so theirs is
+     *        empty.
+     * 
+     * \retval glyph_storage 
+     */
+    glyph_storage storage() const;
 
   private:
-    std::map<int, character> _characters;  //!< maps ascii character values to the character object
+    struct lazy_glyphs;
+
+    font();
+    void build_table();
+    std::optional<glyph> get_code_point(uint32_t code_point) const noexcept;
+
+    static constexpr uint16_t missing_glyph = 0xFFFF;  //!< table entry for encodings the font does not have
+
+    uint16_t _first_encoding;                       //!< encoding of the first entry in the table
+    std::vector<uint16_t> _table;                   //!< glyph index of each encoding from the first to the last one in the font
+    std::vector<character_properties> _properties;  //!< properties of each glyph
+    std::vector<uint32_t> _bitmap_offsets;          //!< first row of each glyph in the bitmap arena
+    std::vector<uint32_t> _bitmaps;                 //!< rows of every glyph back to back
+    std::optional<bounding_box> _bounding_box;      //!< FONTBOUNDINGBOX of the font if it has one
+    int _ascent;                                    //!< FONT_ASCENT of the font
+    std::shared_ptr<const mapped_file> _cache_file; //!< mapped cache that _external points into, shared between copies
+    glyph_storage _external;                        //!< storage the font does not own, used instead of the vectors when set
+    std::shared_ptr<lazy_glyphs> _lazy;             //!< index and decoded glyphs of a lazily loaded font, shared between copies
 };
 };  // namespace fonts
@@ -0,0 +1,128 @@
+/**
+ * \file font_benchmark.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief times loading every BDF font in a directory, parsed and from the binary font cache
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "font_benchmark.hpp"
+#include "font.hpp"
+#include "font_cache.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/********************************** Constants *******************************************/
+#define BENCHMARK_RUNS (5)  //!< loads of each font, the fastest is reported
+#define BENCHMARK_MESSAGE ("Happy Halloween!")  //!< message encoded after a lazy load, which decodes its glyphs
+
+namespace fonts
+{
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief time the fastest of several runs of a loader
+ *
+ * \param load the loader to time
+ * \retval double best time in milliseconds
+ */
+template <typename Loader>
+static double best_time_ms(Loader&& load) {
+    double best = std::numeric_limits<double>::max();
+    for ( int run = 0; run < BENCHMARK_RUNS; run++ ) {
+        const auto start = std::chrono::steady_clock::now();
+        static_cast<void>(load());
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief parse every .bdf file in a directory and report the load times, and the time to open the same font from a font
+ *        cache written to the temporary directory. The lazy column indexes the font and encodes a short message, which
+ *        only decodes the glyphs of that message. The heap column is the glyph storage a parsed font allocates, which a
+ *        cached font maps from the file instead.
+ *
+ * \param directory directory of BDF fonts
+ * \retval int process return value, non-zero if any font failed to parse
+ */
+int benchmark_fonts(const std::string& directory) {
+    std::vector<std::filesystem::path> paths;
+    for ( const auto& entry : std::filesystem::directory_iterator(directory) ) {
+        if ( entry.is_regular_file() && (entry.path().extension() == ".bdf") ) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    const auto cache_directory = std::filesystem::temp_directory_path() / "halloween_font_cache";
+    std::filesystem::create_directories(cache_directory);
+
+    int failures = 0;
+    double total_mmap_ms = 0;
+    double total_stream_ms = 0;
+    double total_cache_ms = 0;
+    double total_lazy_ms = 0;
+    std::uintmax_t total_bytes = 0;
+    std::uintmax_t total_heap_bytes = 0;
+    std::cout << std::left << std::setw(18) << "font" << std::right << std::setw(10) << "bytes" << std::setw(8) << "glyphs" << std::setw(11)
+              << "mmap ms" << std::setw(11) << "stream ms" << std::setw(10) << "MB/s" << std::setw(11) << "cache ms" << std::setw(10) << "lazy ms" << std::setw(10)
+              << "heap KB" << "\n";
+    for ( const auto& path : paths ) {
+        const auto maybe_font = font::from_file(path.string());
+        if ( !maybe_font ) {
+            std::cout << path.filename().string() << ": " << maybe_font.get_error() << "\n";
+            failures++;
+            continue;
+        }
+
+        const auto source = mapped_file::open(path.string());
+        const auto cache_path = (cache_directory / path.filename()).replace_extension(".hfnt").string();
+        std::ofstream cache_file{cache_path, std::ios::binary};
+        if ( !source || !maybe_font.get_value().write_cache(cache_file, font_cache_checksum(source->data(), source->size()), source->size()) ) {
+            std::cout << path.filename().string() << ": could not write " << cache_path << "\n";
+            failures++;
+            continue;
+        }
+        cache_file.close();
+
+        const auto bytes = std::filesystem::file_size(path);
+        const auto heap_bytes = std::filesystem::file_size(cache_path) - sizeof(font_cache_header);
+        const auto mmap_ms = best_time_ms([&] { return font::from_file(path.string()); });
+        const auto stream_ms = best_time_ms([&] { return font::from_stream(std::ifstream{path.string()}); });
+        const auto cache_ms = best_time_ms([&] { return font::from_cache(cache_path, path.string()); });
+        const auto lazy_ms = best_time_ms([&] {
+            const auto lazy_font = font::from_file_lazy(path.string());
+            return lazy_font && lazy_font.get_value().encode(BENCHMARK_MESSAGE);
+        });
+        total_bytes += bytes;
+        total_heap_bytes += heap_bytes;
+        total_mmap_ms += mmap_ms;
+        total_stream_ms += stream_ms;
+        total_cache_ms += cache_ms;
+        total_lazy_ms += lazy_ms;
+        std::cout << std::left << std::setw(18) << path.filename().string() << std::right << std::setw(10) << bytes << std::setw(8)
+                  << maybe_font.get_value().size() << std::fixed << std::setprecision(3) << std::setw(11) << mmap_ms << std::setw(11) << stream_ms
+                  << std::setprecision(1) << std::setw(10) << (bytes / 1.0e3) / mmap_ms << std::setprecision(3) << std::setw(11) << cache_ms
+                  << std::setw(10) << lazy_ms << std::setprecision(1) << std::setw(10) << heap_bytes / 1.0e3 << "\n";
+    }
+    std::cout << std::left << std::setw(18) << "total" << std::right << std::setw(10) << total_bytes << std::setw(8) << "" << std::setprecision(3)
+              << std::setw(11) << total_mmap_ms << std::setw(11) << total_stream_ms << std::setprecision(1) << std::setw(10)
+              << (total_bytes / 1.0e3) / std::max(total_mmap_ms, 1e-9) << std::setprecision(3) << std::setw(11) << total_cache_ms
+              << std::setw(10) << total_lazy_ms << std::setprecision(1) << std::setw(10) << total_heap_bytes / 1.0e3 << "\n";
+    return (failures == 0) ? 0 : 1;
+}
+
+};  // namespace fonts
@@ -0,0 +1,29 @@
+/**
+ * \file font_benchmark.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief times loading every BDF font in a directory
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <string>
+
+namespace fonts
+{
+/********************************** Functions *******************************************/
+/**
+ * \brief parse every .bdf file in a directory through the memory mapped and stream loaders and report the best time of
+ *        each, the glyph count and the throughput. Fonts that fail to parse are reported with the parser error.
+ *
+ * \param directory directory of BDF fonts
+ * \retval int process return value, non-zero if any font failed to parse
+ */
+int benchmark_fonts(const std::string& directory);
+
+};  // namespace fonts
@@ -0,0 +1,189 @@
+/**
+ * \file font_cache.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief loading and writing fonts in the binary font cache format
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "font.hpp"
+#include "font_cache.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace fonts
+{
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief byte offsets of each section of the payload, relative to the end of the header
+ */
+struct payload_layout {
+    std::size_t properties;
+    std::size_t bitmap_offsets;
+    std::size_t bitmaps;
+    std::size_t size;
+};
+
+/**
+ * \brief compute where each section of the payload starts from the counts in a header
+ *
+ * \param header the cache header
+ * \retval payload_layout
+ */
+static payload_layout get_layout(const font_cache_header& header) {
+    payload_layout layout;
+    layout.properties = font_cache_align(sizeof(uint16_t) * header.table_size);
+    layout.bitmap_offsets = font_cache_align(layout.properties + sizeof(character_properties) * header.glyph_count);
+    layout.bitmaps = layout.bitmap_offsets + sizeof(uint32_t) * header.glyph_count;
+    layout.size = layout.bitmaps + sizeof(uint32_t) * header.bitmap_rows;
+    return layout;
+}
+
+/**
+ * \brief check that a mapped cache is complete and was written by this version of the format
+ *
+ * \param file the mapped cache
+ * \retval const font_cache_header* the header, or nullptr if the cache cannot be used
+ */
+static const font_cache_header* validate_cache(const mapped_file& file) {
+    if ( file.size() < sizeof(font_cache_header) ) {
+        return nullptr;
+    }
+    const auto* header = reinterpret_cast<const font_cache_header*>(file.data());
+    if ( (std::memcmp(header->magic, font_cache_magic, sizeof(font_cache_magic)) != 0) || (header->version != font_cache_version) ||
+         (header->properties_size != sizeof(character_properties)) ) {
+        return nullptr;
+    }
+    const auto layout = get_layout(*header);
+    if ( file.size() != sizeof(font_cache_header) + layout.size ) {
+        return nullptr;
+    }
+    const auto* payload = file.data() + sizeof(font_cache_header);
+    if ( font_cache_checksum(payload, layout.size) != header->payload_checksum ) {
+        return nullptr;
+    }
+
+    //!< every glyph index and bitmap offset must stay inside the cache so lookups never need a bounds check
+    const auto* table = reinterpret_cast<const uint16_t*>(payload);
+    const auto* properties = reinterpret_cast<const character_properties*>(payload + layout.properties);
+    const auto* offsets = reinterpret_cast<const uint32_t*>(payload + layout.bitmap_offsets);
+    const bool table_valid = std::all_of(table, table + header->table_size, [&](uint16_t index) {
+        return (index == 0xFFFF) || (index < header->glyph_count);
+    });
+    bool glyphs_valid = true;
+    for ( uint32_t index = 0; index < header->glyph_count; index++ ) {
+        const auto height = std::max<int>(properties[index].b_box.height, 0);
+        glyphs_valid = glyphs_valid && (static_cast<uint64_t>(offsets[index]) + height <= header->bitmap_rows);
+    }
+    return (table_valid && glyphs_valid) ? header : nullptr;
+}
+
+/**
+ * \brief append a value or array as raw bytes followed by padding up to the next four byte boundary
+ *
+ * \param payload the payload being built
+ * \param data first element
+ * \param count number of elements
+ */
+template <typename T>
+static void append_section(std::vector<uint8_t>& payload, const T* data, std::size_t count) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    const auto size = sizeof(T) * count;
+    payload.insert(payload.end(), bytes, bytes + size);
+    payload.resize(payload.size() + font_cache_align(size) - size, 0);
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief factory method to memory map a binary font cache and use it in place, falling back to the BDF source
+ *
+ * \param cache_path path of the font cache
+ * \param source_path path of the BDF file the cache was built from
+ * \retval expected<font, std::string>
+ */
+expected<font, std::string> font::from_cache(const std::string& cache_path, const std::string& source_path) {
+    auto cache = mapped_file::open(cache_path);
+    const auto* header = cache ? validate_cache(*cache) : nullptr;
+    auto source = mapped_file::open(source_path);
+    if ( header == nullptr ) {
+        if ( !source ) {
+            return expected<font, std::string>::error("could not open " + cache_path + " or " + source_path);
+        }
+        source->advise_sequential();
+        return from_buffer(source->view());
+    }
+    if ( source && ((source->size() != header->source_size) ||
+                    (font_cache_checksum(source->data(), source->size()) != header->source_checksum)) ) {
+        //!< the BDF changed since the cache was built
+        return from_buffer(source->view());
+    }
+
+    const auto layout = get_layout(*header);
+    const auto* payload = cache->data() + sizeof(font_cache_header);
+    font cached_font;
+    cached_font._first_encoding = static_cast<uint16_t>(header->first_encoding);
+    cached_font._ascent = header->ascent;
+    if ( header->has_bounding_box != 0 ) {
+        cached_font._bounding_box = bounding_box{header->bounding_box[0], header->bounding_box[1], header->bounding_box[2], header->bounding_box[3]};
+    }
+    cached_font._external = glyph_storage{reinterpret_cast<const uint16_t*>(payload),
+                                          header->table_size,
+                                          reinterpret_cast<const character_properties*>(payload + layout.properties),
+                                          reinterpret_cast<const uint32_t*>(payload + layout.bitmap_offsets),
+                                          reinterpret_cast<const uint32_t*>(payload + layout.bitmaps),
+                                          header->glyph_count,
+                                          header->bitmap_rows};
+    cached_font._cache_file = std::make_shared<const mapped_file>(std::move(*cache));
+    return expected<font, std::string>::success(std::move(cached_font));
+}
+
+/**
+ * \brief write the font in the binary font cache format
+ *
+ * \param output binary stream to write to
+ * \param source_checksum font_cache_checksum of the BDF file the font was parsed from
+ * \param source_size size of the BDF file
+ * \retval true if the whole cache was written
+ */
+bool font::write_cache(std::ostream& output, uint64_t source_checksum, uint64_t source_size) const {
+    const auto glyphs = storage();
+    font_cache_header header{};
+    std::memcpy(header.magic, font_cache_magic, sizeof(font_cache_magic));
+    header.version = font_cache_version;
+    header.properties_size = sizeof(character_properties);
+    header.source_checksum = source_checksum;
+    header.source_size = source_size;
+    if ( _bounding_box ) {
+        header.bounding_box[0] = _bounding_box->width;
+        header.bounding_box[1] = _bounding_box->height;
+        header.bounding_box[2] = _bounding_box->x_origin;
+        header.bounding_box[3] = _bounding_box->y_origin;
+        header.has_bounding_box = 1;
+    }
+    header.ascent = _ascent;
+    header.first_encoding = _first_encoding;
+    header.table_size = static_cast<uint32_t>(glyphs.table_size);
+    header.glyph_count = static_cast<uint32_t>(glyphs.glyph_count);
+    header.bitmap_rows = static_cast<uint32_t>(glyphs.bitmap_rows);
+
+    std::vector<uint8_t> payload;
+    payload.reserve(get_layout(header).size);
+    append_section(payload, glyphs.table, glyphs.table_size);
+    append_section(payload, glyphs.properties, glyphs.glyph_count);
+    append_section(payload, glyphs.bitmap_offsets, glyphs.glyph_count);
+    append_section(payload, glyphs.bitmaps, glyphs.bitmap_rows);
+    header.payload_checksum = font_cache_checksum(payload.data(), payload.size());
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    return static_cast<bool>(output);
+}
+
+};  // namespace fonts
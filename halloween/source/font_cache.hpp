@@ -0,0 +1,90 @@
+/**
+ * \file font_cache.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief binary font cache format that is memory mapped and used in place instead of parsing BDF text
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "character.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace fonts
+{
+/********************************** Constants *******************************************/
+constexpr char font_cache_magic[4] = {'H', 'F', 'N', 'T'};
+constexpr uint16_t font_cache_version = 1;
+
+/********************************** Types *******************************************/
+/**
+ * \brief header at the start of a font cache file. The payload after it is, in order and each padded to four bytes:
+ *        the encoding table (uint16_t per entry), the glyph properties (character_properties per glyph), the offset of
+ *        each glyph's first row (uint32_t per glyph) and the bitmap rows (uint32_t per row). Everything is stored in the
+ *        byte order and layout of the machine that wrote it, so properties_size guards against a layout mismatch.
+ */
+struct font_cache_header {
+    char magic[4];              //!< font_cache_magic
+    uint16_t version;           //!< font_cache_version
+    uint16_t properties_size;   //!< sizeof(character_properties) of the writer
+    uint64_t source_checksum;   //!< checksum of the BDF file the cache was built from
+    uint64_t source_size;       //!< size of the BDF file the cache was built from
+    uint64_t payload_checksum;  //!< checksum of everything after the header
+    int8_t bounding_box[4];     //!< FONTBOUNDINGBOX as width, height, x origin, y origin
+    uint8_t has_bounding_box;   //!< non-zero if the font had a FONTBOUNDINGBOX
+    uint8_t reserved[3];
+    int32_t ascent;             //!< FONT_ASCENT
+    uint32_t first_encoding;    //!< encoding of the first table entry
+    uint32_t table_size;        //!< entries in the encoding table
+    uint32_t glyph_count;       //!< number of glyphs
+    uint32_t bitmap_rows;       //!< number of bitmap rows of all glyphs
+    uint32_t reserved_tail;
+};
+
+static_assert(sizeof(font_cache_header) == 64, "font cache header layout changed");
+static_assert(std::is_standard_layout_v<character_properties> && std::is_trivially_destructible_v<character_properties>,
+              "character properties are used in place from the cache");
+
+/********************************** Functions *******************************************/
+/**
+ * \brief 64-bit FNV-1a style checksum used for the source and payload checksums. It mixes in eight bytes per multiply
+ *        rather than one, so checking a cache costs a small fraction of parsing the font it replaces.
+ *
+ * \param data bytes to hash
+ * \param size number of bytes
+ * \retval uint64_t
+ */
+inline uint64_t font_cache_checksum(const uint8_t* data, std::size_t size) {
+    constexpr uint64_t prime = 1099511628211ull;
+    uint64_t hash = 14695981039346656037ull;
+    std::size_t i = 0;
+    for ( ; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t) ) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for ( ; i < size; i++ ) {
+        hash = (hash ^ data[i]) * prime;
+    }
+    return hash;
+}
+
+/**
+ * \brief round a payload offset up to the next four byte boundary
+ *
+ * \param offset the offset
+ * \retval std::size_t
+ */
+constexpr std::size_t font_cache_align(std::size_t offset) {
+    return (offset + 3) & ~static_cast<std::size_t>(3);
+}
+
+};  // namespace fonts
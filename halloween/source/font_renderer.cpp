@@ -11,6 +11,7 @@
 
 /********************************** Includes *******************************************/
 #include "font_renderer.hpp"
+#include <algorithm>
 
 namespace graphics
 {
@@ -18,16 +19,14 @@ namespace graphics
 /**
  * \brief Construct a new font renderer object
  * 
- * \param characters characters to render
- * \param origin origin to render at
+ * \param layout the laid out text to render
+ * \param origin origin to render at, the top left of the text
  * \param color the color to draw in
- * \param mode the text wrapping mode 
  */
-font_renderer::font_renderer(const std::vector<fonts::character>& characters, graphics::origin origin, graphics::color color, text_wrap_mode mode)
+font_renderer::font_renderer(const text_layout& layout, graphics::origin origin, graphics::color color)
     : shape(origin)
-    , characters(characters)
-    , color(color)
-    , wrap_mode(mode) { }
+    , layout(layout)
+    , color(color) { }
 
 /**
  * \brief render a sequence of characters on the screen
@@ -36,39 +35,71 @@ font_renderer::font_renderer(const std::vector<fonts::character>& characters, gr
  * \retval frame new frame
  */
 frame& font_renderer::draw(frame& canvas) {
-    //!< get the frame size to make sure we don't draw outside the limits of the frame
-    const auto width = canvas.width();
-
-    int y_offset{0};
-    int x_offset{0};
-
-    for ( size_t character_count = 0; character_count < characters.size(); character_count++ ) {
-        //!< get the current character
-        auto character = characters[character_count];
+    const auto& glyphs = layout.glyphs();
+    for ( size_t character_count = 0; character_count < glyphs.size(); character_count++ ) {
+        const auto& glyph = glyphs[character_count];
+        const auto& position = layout.position(character_count);
 
-        //!< get the bit alignment of the font data within the character encoding
-        auto bbox = character.properties.b_box;
-        auto alignment = (bbox.width % 8 == 0) ? (bbox.width / 8) : (bbox.width / 8) + 1;
-        uint32_t pixel_alignment = alignment << 8ul;
+        //!< draw the lit runs of the character
+        const auto* spans = glyphs.spans(glyph);
+        for ( uint32_t span = 0; span < glyph.span_count; span++ ) {
+            const auto x = _origin.x + position.x + spans[span].column;
+            const auto y = _origin.y + position.y + spans[span].row;
+            for ( int i = 0; i < spans[span].length; i++ ) {
+                canvas.set_pixel(x + i, y, color);
+            }
+        }
+    }
+    return canvas;
+}
 
-        //!< check for text wrapping and update the row draw position if required
-        auto wraps = (x_offset + bbox.width >= width);
-        x_offset = (wraps && (wrap_mode == text_wrap_mode::wrap)) ? 0 : x_offset;
-        y_offset = (wraps && (wrap_mode == text_wrap_mode::wrap)) ? y_offset + bbox.height : y_offset;
+/**
+ * \brief Construct a new scaled font renderer object
+ * 
+ * \param layout the laid out text to render
+ * \param cache cache of scaled glyphs
+ * \param style the scale and effect, the scale is clamped to between 1 and max_glyph_scale
+ * \param origin origin to render at, the top left of the text
+ * \param color the color to draw the text in
+ * \param effect_color the color to draw the outline or shadow in
+ */
+scaled_font_renderer::scaled_font_renderer(const text_layout& layout,
+                                           scaled_glyph_cache& cache,
+                                           text_style style,
+                                           graphics::origin origin,
+                                           graphics::color color,
+                                           graphics::color effect_color)
+    : shape(origin)
+    , layout(layout)
+    , cache(cache)
+    , style{static_cast<uint8_t>(std::clamp<int>(style.scale, 1, max_glyph_scale)), style.effect}
+    , color(color)
+    , effect_color(effect_color) { }
 
-        //!< draw the character
-        for ( int j = 0; j < character.properties.b_box.height; j++ ) {
-            for ( int i = 0; i < character.properties.b_box.width; i++ ) {
-                if ( character.bitmap[j] & (pixel_alignment >> i) ) {
-                    auto x = _origin.x + x_offset + i;
-                    auto y = _origin.y + y_offset + j;
-                    canvas.set_pixel(x, y, color);
+/**
+ * \brief render a sequence of characters on the screen
+ * 
+ * \param canvas existing frame canvas
+ * \retval frame new frame
+ */
+frame& scaled_font_renderer::draw(frame& canvas) {
+    //!< effects are drawn in a first pass, then the characters on top of them
+    const int first_pass = (style.effect == glyph_effect::none) ? 1 : 0;
+    for ( int pass = first_pass; pass < 2; pass++ ) {
+        const auto pass_color = (pass == 0) ? effect_color : color;
+        for ( std::size_t character_count = 0; character_count < layout.size(); character_count++ ) {
+            const auto& glyph = cache.get(layout.character(character_count), style);
+            const auto& position = layout.position(character_count);
+            const int x = _origin.x + position.x * style.scale;
+            const int y = _origin.y + position.y * style.scale;
+            const auto first = (pass == 0) ? glyph.spans.begin() : glyph.spans.begin() + glyph.effect_span_count;
+            const auto last = (pass == 0) ? glyph.spans.begin() + glyph.effect_span_count : glyph.spans.end();
+            for ( auto span = first; span != last; span++ ) {
+                for ( int i = 0; i < span->length; i++ ) {
+                    canvas.set_pixel(x + span->column + i, y + span->row, pass_color);
                 }
             }
         }
-
-        //!< update the x-draw position for the next character
-        x_offset += bbox.width;
     }
     return canvas;
 }
@@ -16,17 +16,16 @@
 /********************************** Includes *******************************************/
 #include "font.hpp"
 #include "primatives.hpp"
+#include "scaled_glyph_cache.hpp"
+#include "text_layout.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace graphics
 {
 /********************************** Types *******************************************/
-/**
- * \brief options for handling string wrapping
- * 
- */
-enum class text_wrap_mode : unsigned { none = 0, wrap };
-
 /**
  * \brief shape type that handles drawing bitmapped fonts
  */
@@ -34,27 +33,149 @@ struct font_renderer : public shape {
     /**
      * \brief Construct a new font renderer object
      * 
-     * \param characters characters to render
-     * \param origin origin to render at
+     * \param layout the laid out text to render
+     * \param origin origin to render at, the top left of the text
      * \param color the color to draw the text in
-     * \param mode the text wrap mode
      */
-    font_renderer(const std::vector<fonts::character>& characters,
-                  graphics::origin origin,
-                  graphics::color color,
-                  text_wrap_mode mode = text_wrap_mode::none);
+    font_renderer(const text_layout& layout, graphics::origin origin, graphics::color color);
 
     /**
-     * \brief render a sequence of characters on the screen
+     * \brief render a sequence of characters on the screen. Glyphs are drawn from the spans decoded by the layout, at the
+     *        positions it placed them.
      * 
      * \param canvas existing frame canvas
      * \retval the drawing frame
      */
     frame& draw(frame& canvas);
 
-    const std::vector<fonts::character>& characters;
+    const text_layout& layout;
+    graphics::color color;
+};
+
+/**
+ * \brief font renderer that draws text scaled up by an integer factor, optionally with an outline or a shadow. The scaled
+ *        glyphs come from a scaled_glyph_cache, so each glyph is scaled once and drawing only copies its spans.
+ */
+struct scaled_font_renderer : public shape {
+    /**
+     * \brief Construct a new scaled font renderer object
+     * 
+     * \param layout the laid out text to render, which is scaled with the glyphs
+     * \param cache cache of scaled glyphs, which can be shared between renderers
+     * \param style the scale and effect
+     * \param origin origin to render at, the top left of the text
+     * \param color the color to draw the text in
+     * \param effect_color the color to draw the outline or shadow in
+     */
+    scaled_font_renderer(const text_layout& layout,
+                         scaled_glyph_cache& cache,
+                         text_style style,
+                         graphics::origin origin,
+                         graphics::color color,
+                         graphics::color effect_color = {0, 0, 0});
+
+    /**
+     * \brief render a sequence of characters on the screen. The effects of all characters are drawn before the
+     *        characters so a shadow never covers the character next to it.
+     * 
+     * \param canvas existing frame canvas
+     * \retval the drawing frame
+     */
+    frame& draw(frame& canvas);
+
+    const text_layout& layout;
+    scaled_glyph_cache& cache;
+    text_style style;
+    graphics::color color;
+    graphics::color effect_color;
+};
+
+/**
+ * \brief font renderer for fonts where every glyph is Width x Height pixels, such as the fixed size embedded fonts. The
+ *        row and column loops are unrolled and the bit of each pixel is a constant, so drawing a glyph is a fixed
+ *        sequence of bit tests. Glyphs of any other size, e.g. from a runtime loaded font, are drawn with plain loops.
+ *        The glyphs are drawn where the text_layout placed them.
+ *
+ * \tparam Width glyph width in pixels
+ * \tparam Height glyph height in pixels
+ */
+template <int Width, int Height>
+struct fixed_size_font_renderer : public shape {
+    static_assert((Width > 0) && (Width <= 32) && (Height > 0), "glyphs must be between 1 and 32 pixels wide");
+
+    /**
+     * \brief Construct a new fixed size font renderer object
+     * 
+     * \param layout the laid out text to render
+     * \param origin origin to render at, the top left of the text
+     * \param color the color to draw the text in
+     */
+    fixed_size_font_renderer(const text_layout& layout, graphics::origin origin, graphics::color color)
+        : shape(origin)
+        , layout(layout)
+        , color(color) { }
+
+    /**
+     * \brief render a sequence of characters on the screen
+     * 
+     * \param canvas existing frame canvas
+     * \retval the drawing frame
+     */
+    frame& draw(frame& canvas) {
+        for ( std::size_t index = 0; index < layout.size(); index++ ) {
+            const auto& glyph = layout.character(index);
+            const auto& position = layout.position(index);
+            const auto x = _origin.x + position.x;
+            const auto y = _origin.y + position.y;
+            const auto& box = glyph.properties->b_box;
+            if ( (box.width == Width) && (box.height == Height) ) {
+                draw_rows(canvas, glyph.bitmap, x, y, std::make_index_sequence<Height>{});
+            } else {
+                draw_any(canvas, glyph, x, y);
+            }
+        }
+        return canvas;
+    }
+
+    const text_layout& layout;
     graphics::color color;
-    text_wrap_mode wrap_mode;
+
+  private:
+    static constexpr uint32_t first_pixel = 1ul << (8 * ((Width + 7) / 8) - 1);  //!< bit of the leftmost pixel in a row
+
+    /**
+     * \brief draw every row of a Width x Height glyph
+     */
+    template <std::size_t... Rows>
+    void draw_rows(frame& canvas, const uint32_t* bitmap, int x, int y, std::index_sequence<Rows...>) {
+        (draw_row<Rows>(canvas, bitmap[Rows], x, y, std::make_index_sequence<Width>{}), ...);
+    }
+
+    /**
+     * \brief draw the lit pixels of one glyph row
+     */
+    template <std::size_t Row, std::size_t... Columns>
+    void draw_row(frame& canvas, uint32_t row, int x, int y, std::index_sequence<Columns...>) {
+        (((row & (first_pixel >> Columns)) != 0 ? canvas.set_pixel(x + static_cast<int>(Columns), y + static_cast<int>(Row), color) : void()), ...);
+    }
+
+    /**
+     * \brief draw a glyph of any size pixel by pixel
+     */
+    void draw_any(frame& canvas, const fonts::glyph& glyph, int x, int y) {
+        const int glyph_width = std::min<int>(glyph.properties->b_box.width, 32);
+        if ( glyph_width <= 0 ) {
+            return;
+        }
+        const uint32_t glyph_first_pixel = 1ul << (8 * ((glyph_width + 7) / 8) - 1);
+        for ( int row = 0; row < glyph.properties->b_box.height; row++ ) {
+            for ( int column = 0; column < glyph_width; column++ ) {
+                if ( (glyph.bitmap[row] & (glyph_first_pixel >> column)) != 0 ) {
+                    canvas.set_pixel(x + column, y + row, color);
+                }
+            }
+        }
+    }
 };
 
 };  // namespace graphics
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * \file frame_scheduler.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief paces animation frames by sleeping until fixed deadlines on the monotonic clock
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "frame_scheduler.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <time.h>
+
+namespace graphics
+{
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief sleep until an absolute time on the monotonic clock. steady_clock is CLOCK_MONOTONIC on Linux, so its
+ *        time points can be passed straight to clock_nanosleep.
+ *
+ * \param deadline time to wake up at
+ */
+static void sleep_until(frame_scheduler::clock::time_point deadline) {
+    const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    timespec wake_time{};
+    wake_time.tv_sec = static_cast<time_t>(seconds.count());
+    wake_time.tv_nsec = static_cast<long>((since_epoch - seconds).count());
+
+    //!< an absolute sleep can simply be restarted when a signal interrupts it
+    while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_time, nullptr) == EINTR ) { }
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new frame scheduler. The first deadline is one period from now.
+ *
+ * \param period time between frames
+ */
+frame_scheduler::frame_scheduler(clock::duration period)
+    : _period(period) {
+    restart();
+}
+
+/**
+ * \brief sleep until the next deadline
+ *
+ * \retval clock::time_point the time the thread woke up
+ */
+frame_scheduler::clock::time_point frame_scheduler::wait() {
+    _frames++;
+    const auto now = clock::now();
+    if ( now >= _deadline ) {
+        //!< the frame overran: drop every deadline that has passed and don't sleep
+        const auto lateness = now - _deadline;
+        const auto skipped = (_period.count() > 0) ? lateness / _period : 0;
+        _missed += static_cast<uint64_t>(skipped) + 1;
+        _worst_lateness = std::max(_worst_lateness, lateness);
+        _deadline += _period * (skipped + 1);
+        return now;
+    }
+
+    sleep_until(_deadline);
+    _deadline += _period;
+    return clock::now();
+}
+
+/**
+ * \brief restart the schedule one period from now and reset the counters
+ */
+void frame_scheduler::restart() {
+    _deadline = clock::now() + _period;
+    _frames = 0;
+    _missed = 0;
+    _worst_lateness = clock::duration::zero();
+}
+
+/**
+ * \brief get the number of frames waited for since the last restart
+ *
+ * \retval uint64_t
+ */
+uint64_t frame_scheduler::frames() const {
+    return _frames;
+}
+
+/**
+ * \brief get the number of deadlines that had already passed when wait was called
+ *
+ * \retval uint64_t
+ */
+uint64_t frame_scheduler::missed_deadlines() const {
+    return _missed;
+}
+
+/**
+ * \brief get the latest a frame was called relative to its deadline
+ *
+ * \retval clock::duration
+ */
+frame_scheduler::clock::duration frame_scheduler::worst_lateness() const {
+    return _worst_lateness;
+}
+
+/**
+ * \brief write the frame and missed deadline counters on one line
+ *
+ * \param stream the stream to write to
+ * \param name what the frames were drawing
+ */
+void frame_scheduler::report(std::ostream& stream, const std::string& name) const {
+    const std::chrono::duration<double, std::milli> worst = _worst_lateness;
+    stream << name << ": " << _frames << " frames, " << _missed << " missed deadlines, worst " << worst.count() << " ms late\n";
+}
+
+};  // namespace graphics
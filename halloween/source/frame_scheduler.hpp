@@ -0,0 +1,90 @@
+/**
+ * \file frame_scheduler.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief paces animation frames by sleeping until fixed deadlines on the monotonic clock
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace graphics
+{
+/********************************** Types *******************************************/
+/**
+ * \brief sleeps the calling thread until the next frame deadline instead of spinning, so the animation
+ *        thread leaves the CPU to the matrix refresh thread between frames. Deadlines are on steady_clock,
+ *        which does not jump when NTP adjusts the wall clock. A frame that finishes after the next deadline
+ *        counts as missed: the skipped deadlines are dropped and the schedule continues from the next one
+ *        in the future, so a stall never causes a burst of catch up frames.
+ */
+class frame_scheduler {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * \brief Construct a new frame scheduler. The first deadline is one period from now.
+     *
+     * \param period time between frames
+     */
+    explicit frame_scheduler(clock::duration period);
+
+    /**
+     * \brief sleep until the next deadline
+     *
+     * \retval clock::time_point the time the thread woke up, which renderers use to position the frame
+     */
+    clock::time_point wait();
+
+    /**
+     * \brief restart the schedule one period from now and reset the counters
+     */
+    void restart();
+
+    /**
+     * \brief get the number of frames waited for since the last restart
+     *
+     * \retval uint64_t
+     */
+    uint64_t frames() const;
+
+    /**
+     * \brief get the number of deadlines that had already passed when wait was called
+     *
+     * \retval uint64_t
+     */
+    uint64_t missed_deadlines() const;
+
+    /**
+     * \brief get the latest a frame was called relative to its deadline
+     *
+     * \retval clock::duration
+     */
+    clock::duration worst_lateness() const;
+
+    /**
+     * \brief write the frame and missed deadline counters on one line
+     *
+     * \param stream the stream to write to
+     * \param name what the frames were drawing
+     */
+    void report(std::ostream& stream, const std::string& name) const;
+
+  private:
+    clock::duration _period;
+    clock::time_point _deadline;
+    uint64_t _frames;
+    uint64_t _missed;
+    clock::duration _worst_lateness;
+};
+
+};  // namespace graphics
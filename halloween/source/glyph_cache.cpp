@@ -0,0 +1,77 @@
+/**
+ * \file glyph_cache.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief pre-rasterized glyphs for the font renderers so that drawing does no bit decoding or allocation
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "glyph_cache.hpp"
+#include <algorithm>
+#include <map>
+
+/********************************** Constants *******************************************/
+#define MAX_GLYPH_WIDTH (32)  //!< widest row a uint32_t bitmap row can hold
+
+namespace graphics
+{
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new glyph cache object from the characters of a message
+ *
+ * \param characters the encoded message
+ */
+glyph_cache::glyph_cache(const std::vector<fonts::glyph>& characters) {
+    std::map<uint16_t, uint16_t> indices;
+    _message.reserve(characters.size());
+    for ( const auto& character : characters ) {
+        auto [entry, inserted] = indices.try_emplace(character.properties->encoding, static_cast<uint16_t>(_glyphs.size()));
+        if ( inserted ) {
+            rasterize(character);
+        }
+        _message.push_back(entry->second);
+    }
+}
+
+/**
+ * \brief decode a glyph bitmap into the arenas. BDF rows are left aligned in whole bytes, so the first pixel of a row
+ *        is the top bit of its last byte.
+ *
+ * \param character the glyph to decode
+ */
+void glyph_cache::rasterize(const fonts::glyph& character) {
+    const auto& bbox = character.properties->b_box;
+    const auto width = std::clamp<int>(bbox.width, 0, MAX_GLYPH_WIDTH);
+    const auto height = std::max<int>(bbox.height, 0);
+    const auto bytes_per_row = (width + 7) / 8;
+    const uint32_t first_pixel = (bytes_per_row > 0) ? (1ul << (8 * bytes_per_row - 1)) : 0;
+
+    cached_glyph glyph{static_cast<uint8_t>(width),
+                       static_cast<uint8_t>(height),
+                       static_cast<uint32_t>(_masks.size()),
+                       static_cast<uint32_t>(_spans.size()),
+                       0};
+    for ( int row = 0; row < height; row++ ) {
+        int run_start = -1;
+        for ( int column = 0; column <= width; column++ ) {
+            const bool lit = (column < width) && (character.bitmap[row] & (first_pixel >> column));
+            if ( column < width ) {
+                _masks.push_back(lit ? 1 : 0);
+            }
+            if ( lit && (run_start < 0) ) {
+                run_start = column;
+            } else if ( !lit && (run_start >= 0) ) {
+                _spans.push_back(glyph_span{static_cast<uint8_t>(row), static_cast<uint8_t>(run_start), static_cast<uint8_t>(column - run_start)});
+                run_start = -1;
+            }
+        }
+    }
+    glyph.span_count = static_cast<uint32_t>(_spans.size()) - glyph.span_offset;
+    _glyphs.push_back(glyph);
+}
+
+};  // namespace graphics
@@ -0,0 +1,104 @@
+/**
+ * \file glyph_cache.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief pre-rasterized glyphs for the font renderers so that drawing does no bit decoding or allocation
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "character.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace graphics
+{
+/********************************** Types *******************************************/
+/**
+ * \brief horizontal run of lit pixels in a glyph
+ */
+struct glyph_span {
+    uint8_t row;     //!< row of the run from the top of the glyph
+    uint8_t column;  //!< first lit column
+    uint8_t length;  //!< number of lit pixels
+};
+
+/**
+ * \brief a glyph decoded into a byte mask and a list of lit spans stored in the cache arenas
+ */
+struct cached_glyph {
+    uint8_t width;         //!< width of the glyph in pixels
+    uint8_t height;        //!< height of the glyph in pixels
+    uint32_t mask_offset;  //!< offset of the width * height byte mask, one byte per pixel, 1 if lit
+    uint32_t span_offset;  //!< offset of the first span
+    uint32_t span_count;   //!< number of spans
+};
+
+/**
+ * \brief decodes each distinct glyph of a message once. The masks and spans of every glyph share two contiguous arenas,
+ *        and the message is kept as one glyph index per character so repeated characters are decoded once.
+ */
+class glyph_cache {
+  public:
+    /**
+     * \brief Construct a new glyph cache object from the characters of a message
+     *
+     * \param characters the encoded message
+     */
+    explicit glyph_cache(const std::vector<fonts::glyph>& characters);
+
+    /**
+     * \brief get the glyph of a character in the message
+     *
+     * \param index position of the character in the message
+     * \retval const cached_glyph&
+     */
+    const cached_glyph& operator[](std::size_t index) const {
+        return _glyphs[_message[index]];
+    }
+
+    /**
+     * \brief number of characters in the message
+     *
+     * \retval std::size_t
+     */
+    std::size_t size() const {
+        return _message.size();
+    }
+
+    /**
+     * \brief get the lit spans of a glyph, glyph.span_count long
+     *
+     * \param glyph the glyph
+     * \retval const glyph_span*
+     */
+    const glyph_span* spans(const cached_glyph& glyph) const {
+        return _spans.data() + glyph.span_offset;
+    }
+
+    /**
+     * \brief get the byte mask of a glyph, row major and glyph.width * glyph.height long
+     *
+     * \param glyph the glyph
+     * \retval const uint8_t*
+     */
+    const uint8_t* mask(const cached_glyph& glyph) const {
+        return _masks.data() + glyph.mask_offset;
+    }
+
+  private:
+    void rasterize(const fonts::glyph& character);
+
+    std::vector<cached_glyph> _glyphs;   //!< one entry per distinct encoding
+    std::vector<uint16_t> _message;      //!< glyph index of each character in the message
+    std::vector<glyph_span> _spans;      //!< span arena
+    std::vector<uint8_t> _masks;         //!< mask arena
+};
+
+};  // namespace graphics
@@ -14,3 +14,4 @@
 #include "primatives.hpp"
 #include "font_renderer.hpp"
 #include "scrolling_font_renderer.hpp"
+#include "frame_scheduler.hpp"
@@ -13,6 +13,8 @@
 #include "config_parser.hpp"
 #include "expected.hpp"
 #include "animation.hpp"
+#include "embedded_fonts.hpp"
+#include "font_benchmark.hpp"
 #include "graphics.hpp"
 #include "led-matrix.h"
 #include "nlohmann/json.hpp"
@@ -20,6 +22,7 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -28,21 +31,27 @@ using json = nlohmann::json;
 
 /****************************** Function Definitions ***********************************/
 /**
- * \brief main application entry point.
+ * \brief main application entry point. Pass --benchmark-fonts <directory> to time loading every BDF font in a directory
+ *        and exit.
  * 
  * \param argc number of command line arguments
  * \param argv space delimited command line arguments
  * \retval int process return value
  */
 int main(int argc, char* argv[]) {
+    for ( int i = 1; i + 1 < argc; i++ ) {
+        if ( std::string{argv[i]} == "--benchmark-fonts" ) {
+            return fonts::benchmark_fonts(argv[i + 1]);
+        }
+    }
+
     // load and parse configuration
     json config = json::parse(std::ifstream{"/home/pi/halloween/config.json"});
     auto maybe_options = create_options_from_json(config);
-    auto options = maybe_options.get_value();
+    auto options = std::move(maybe_options).get_value();
 
-    // load a font file
-    auto maybe_font = fonts::font::from_stream(std::ifstream{std::string{"/home/pi/halloween/fonts/7x13B.bdf"}});
-    auto font = maybe_font.get_value();
+    // the font is compiled into the binary from graphics/fonts/7x13B.bdf, see EMBEDDED_FONTS
+    auto font = fonts::embedded::font_7x13B.load();
 
     //!< create the RGB Matrix object from the validated options.
     auto matrix = std::unique_ptr<rgb_matrix::RGBMatrix>(rgb_matrix::CreateMatrixFromOptions(options.options, options.runtime_options));
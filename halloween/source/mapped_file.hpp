@@ -0,0 +1,110 @@
+/**
+ * \file mapped_file.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief read only memory mapped file
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+/********************************** Types *******************************************/
+/**
+ * \brief move only owner of a read only, private mapping of a whole file. The pages are only read in as they are touched,
+ *        and they are shared with the page cache rather than copied into the heap.
+ */
+class mapped_file {
+  public:
+    /**
+     * \brief map a file
+     *
+     * \param path path of the file
+     * \retval std::optional<mapped_file> the mapping, or nothing if the file could not be opened or is empty
+     */
+    static std::optional<mapped_file> open(const std::string& path) {
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        if ( descriptor < 0 ) {
+            return std::nullopt;
+        }
+        struct stat status;
+        if ( (fstat(descriptor, &status) != 0) || (status.st_size <= 0) ) {
+            close(descriptor);
+            return std::nullopt;
+        }
+        const auto size = static_cast<std::size_t>(status.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if ( data == MAP_FAILED ) {
+            return std::nullopt;
+        }
+        return mapped_file{data, size};
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : _data(std::exchange(other._data, nullptr))
+        , _size(std::exchange(other._size, 0)) { }
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if ( this != &other ) {
+            unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        unmap();
+    }
+
+    /**
+     * \brief hint that the file will be read front to back once
+     */
+    void advise_sequential() const {
+        madvise(_data, _size, MADV_SEQUENTIAL);
+    }
+
+    const uint8_t* data() const {
+        return static_cast<const uint8_t*>(_data);
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    std::string_view view() const {
+        return std::string_view{static_cast<const char*>(_data), _size};
+    }
+
+  private:
+    mapped_file(void* data, std::size_t size)
+        : _data(data)
+        , _size(size) { }
+
+    void unmap() {
+        if ( _data != nullptr ) {
+            munmap(_data, _size);
+        }
+    }
+
+    void* _data;
+    std::size_t _size;
+};
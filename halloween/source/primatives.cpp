@@ -51,6 +51,17 @@ void frame::set_pixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+/**
+ * \brief Set a pixel that the caller has already clipped to the frame
+ * 
+ * \param x coordinate to set at
+ * \param y coordinate to set at
+ * \param pixel the pixel to set
+ */
+void frame::set_pixel_unchecked(int x, int y, const pixel& pixel) {
+    _canvas->SetPixel(x, y, pixel.red, pixel.green, pixel.blue);
+}
+
 /**
  * \brief clear the canvas
  */
@@ -75,6 +75,16 @@ class frame {
      */
     void set_pixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue);
 
+    /**
+     * \brief Set a pixel without the bounds check. Only for callers that have already clipped
+     *        their drawing to the frame.
+     * 
+     * \param x coordinate to set at, must be inside the frame
+     * \param y coordinate to set at, must be inside the frame
+     * \param pixel color information to set
+     */
+    void set_pixel_unchecked(int x, int y, const pixel& pixel);
+
     /**
      * \brief Get the width of the frame
      * 
@@ -0,0 +1,152 @@
+/**
+ * \file scaled_glyph_cache.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief bounded cache of glyphs scaled up by an integer factor, with an optional outline or shadow
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "scaled_glyph_cache.hpp"
+#include <algorithm>
+
+/********************************** Constants *******************************************/
+#define MAX_GLYPH_WIDTH (32)  //!< widest row a uint32_t bitmap row can hold
+
+namespace graphics
+{
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief append the runs of set bytes in a mask as spans
+ *
+ * \param spans the spans to append to
+ * \param mask row major mask
+ * \param width width of the mask
+ * \param height height of the mask
+ * \param left column of the mask that is column 0 of the glyph
+ * \param top row of the mask that is row 0 of the glyph
+ */
+static void append_spans(std::vector<scaled_span>& spans, const std::vector<uint8_t>& mask, int width, int height, int left, int top) {
+    for ( int row = 0; row < height; row++ ) {
+        const auto* line = mask.data() + row * width;
+        int run_start = -1;
+        for ( int column = 0; column <= width; column++ ) {
+            const bool lit = (column < width) && (line[column] != 0);
+            if ( lit && (run_start < 0) ) {
+                run_start = column;
+            } else if ( !lit && (run_start >= 0) ) {
+                spans.push_back(scaled_span{static_cast<int16_t>(row - top), static_cast<int16_t>(run_start - left), static_cast<uint16_t>(column - run_start)});
+                run_start = -1;
+            }
+        }
+    }
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief scale a glyph and add its effect
+ *
+ * \param character the glyph
+ * \param style the scale and effect
+ * \retval scaled_glyph
+ */
+scaled_glyph scale_glyph(const fonts::glyph& character, text_style style) {
+    const int scale = std::clamp<int>(style.scale, 1, max_glyph_scale);
+    const auto& bbox = character.properties->b_box;
+    const auto width = std::clamp<int>(bbox.width, 0, MAX_GLYPH_WIDTH);
+    const auto height = std::max<int>(bbox.height, 0);
+    const auto bytes_per_row = (width + 7) / 8;
+    const uint32_t first_pixel = (bytes_per_row > 0) ? (1ul << (8 * bytes_per_row - 1)) : 0;
+
+    //!< the mask has room for the effect around the scaled glyph
+    const int left = (style.effect == glyph_effect::outline) ? 1 : 0;
+    const int top = left;
+    const int right = (style.effect == glyph_effect::outline) ? 1 : (style.effect == glyph_effect::shadow) ? scale : 0;
+    const int bottom = right;
+    const int mask_width = width * scale + left + right;
+    const int mask_height = height * scale + top + bottom;
+    std::vector<uint8_t> fill(mask_width * mask_height, 0);
+    for ( int row = 0; row < height; row++ ) {
+        for ( int column = 0; column < width; column++ ) {
+            if ( (character.bitmap[row] & (first_pixel >> column)) == 0 ) {
+                continue;
+            }
+            for ( int y = 0; y < scale; y++ ) {
+                auto* line = fill.data() + (top + row * scale + y) * mask_width + left + column * scale;
+                std::fill(line, line + scale, 1);
+            }
+        }
+    }
+
+    //!< the outline is every unlit pixel next to a lit one, the shadow is the glyph shifted by one source pixel
+    std::vector<uint8_t> effect(fill.size(), 0);
+    for ( int y = 0; y < mask_height; y++ ) {
+        for ( int x = 0; x < mask_width; x++ ) {
+            if ( fill[y * mask_width + x] != 0 ) {
+                continue;
+            }
+            bool lit = false;
+            if ( style.effect == glyph_effect::outline ) {
+                for ( int dy = -1; (dy <= 1) && !lit; dy++ ) {
+                    for ( int dx = -1; (dx <= 1) && !lit; dx++ ) {
+                        const int nx = x + dx;
+                        const int ny = y + dy;
+                        lit = (nx >= 0) && (ny >= 0) && (nx < mask_width) && (ny < mask_height) && (fill[ny * mask_width + nx] != 0);
+                    }
+                }
+            } else if ( style.effect == glyph_effect::shadow ) {
+                lit = (x >= scale) && (y >= scale) && (fill[(y - scale) * mask_width + x - scale] != 0);
+            }
+            effect[y * mask_width + x] = lit ? 1 : 0;
+        }
+    }
+
+    scaled_glyph glyph{{}, 0};
+    append_spans(glyph.spans, effect, mask_width, mask_height, left, top);
+    glyph.effect_span_count = glyph.spans.size();
+    append_spans(glyph.spans, fill, mask_width, mask_height, left, top);
+    glyph.spans.shrink_to_fit();
+    return glyph;
+}
+
+/**
+ * \brief Construct a new scaled glyph cache object
+ *
+ * \param capacity_bytes largest total size of the cached glyphs. A single glyph larger than this is still cached.
+ */
+scaled_glyph_cache::scaled_glyph_cache(std::size_t capacity_bytes)
+    : _capacity_bytes(capacity_bytes)
+    , _size_bytes(0) { }
+
+/**
+ * \brief get a glyph scaled and styled, building it if it is not cached
+ *
+ * \param character the glyph
+ * \param style the scale and effect
+ * \retval const scaled_glyph& valid until the next call
+ */
+const scaled_glyph& scaled_glyph_cache::get(const fonts::glyph& character, text_style style) {
+    style.scale = static_cast<uint8_t>(std::clamp<int>(style.scale, 1, max_glyph_scale));
+    const key id{character.properties, style.scale, style.effect};
+    if ( auto found = _index.find(id); found != _index.end() ) {
+        _entries.splice(_entries.begin(), _entries, found->second);
+        return found->second->glyph;
+    }
+
+    auto glyph = scale_glyph(character, style);
+    const auto size_bytes = sizeof(entry) + glyph.spans.size() * sizeof(scaled_span);
+    while ( !_entries.empty() && (_size_bytes + size_bytes > _capacity_bytes) ) {
+        _size_bytes -= _entries.back().size_bytes;
+        _index.erase(_entries.back().id);
+        _entries.pop_back();
+    }
+    _entries.push_front(entry{id, std::move(glyph), size_bytes});
+    _index.emplace(id, _entries.begin());
+    _size_bytes += size_bytes;
+    return _entries.front().glyph;
+}
+
+};  // namespace graphics
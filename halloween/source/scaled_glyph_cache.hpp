@@ -0,0 +1,146 @@
+/**
+ * \file scaled_glyph_cache.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief bounded cache of glyphs scaled up by an integer factor, with an optional outline or shadow
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "character.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace graphics
+{
+/********************************** Constants *******************************************/
+constexpr uint8_t max_glyph_scale = 8;  //!< largest scale factor of a scaled glyph
+
+/********************************** Types *******************************************/
+/**
+ * \brief effect drawn behind a scaled glyph
+ */
+enum class glyph_effect : uint8_t {
+    none = 0,  //!< just the glyph
+    outline,   //!< a one pixel border around the lit pixels
+    shadow     //!< the glyph shifted one source pixel right and down
+};
+
+/**
+ * \brief how scaled text is drawn
+ */
+struct text_style {
+    uint8_t scale;        //!< integer scale factor, from 1 to max_glyph_scale
+    glyph_effect effect;  //!< effect drawn behind the glyphs
+};
+
+/**
+ * \brief horizontal run of lit pixels in a scaled glyph
+ */
+struct scaled_span {
+    int16_t row;      //!< row of the run, relative to the top of the scaled glyph
+    int16_t column;   //!< first lit column, relative to the left of the scaled glyph
+    uint16_t length;  //!< number of lit pixels
+};
+
+/**
+ * \brief a glyph scaled up and run length encoded. The effect spans come first so they can be drawn underneath the glyph.
+ *        Spans can start left of or above the glyph, where the outline extends past it.
+ */
+struct scaled_glyph {
+    std::vector<scaled_span> spans;  //!< effect spans followed by glyph spans
+    std::size_t effect_span_count;   //!< number of effect spans at the start of spans
+};
+
+/**
+ * \brief cache of scaled glyphs that are built the first time they are drawn, so drawing scaled text only copies spans.
+ *        The cache holds at most capacity_bytes of spans and evicts the least recently used glyph when it is full.
+ */
+class scaled_glyph_cache {
+  public:
+    /**
+     * \brief Construct a new scaled glyph cache object
+     *
+     * \param capacity_bytes largest total size of the cached glyphs
+     */
+    explicit scaled_glyph_cache(std::size_t capacity_bytes);
+
+    /**
+     * \brief get a glyph scaled and styled, building it if it is not cached. The reference is valid until the next call.
+     *
+     * \param character the glyph, which must stay alive while it is cached
+     * \param style the scale and effect. The scale is clamped to between 1 and max_glyph_scale.
+     * \retval const scaled_glyph&
+     */
+    const scaled_glyph& get(const fonts::glyph& character, text_style style);
+
+    /**
+     * \brief get the number of cached glyphs
+     *
+     * \retval std::size_t
+     */
+    std::size_t size() const {
+        return _entries.size();
+    }
+
+    /**
+     * \brief get the total size of the cached glyphs
+     *
+     * \retval std::size_t
+     */
+    std::size_t size_bytes() const {
+        return _size_bytes;
+    }
+
+  private:
+    /**
+     * \brief a glyph in a style, identified by its properties, which are unique to each glyph of a font
+     */
+    struct key {
+        const fonts::character_properties* properties;
+        uint8_t scale;
+        glyph_effect effect;
+
+        bool operator==(const key& other) const {
+            return (properties == other.properties) && (scale == other.scale) && (effect == other.effect);
+        }
+    };
+
+    struct key_hash {
+        std::size_t operator()(const key& value) const {
+            return std::hash<const void*>{}(value.properties) ^ (static_cast<std::size_t>(value.scale) << 2) ^ static_cast<std::size_t>(value.effect);
+        }
+    };
+
+    struct entry {
+        key id;
+        scaled_glyph glyph;
+        std::size_t size_bytes;
+    };
+
+    std::size_t _capacity_bytes;                                           //!< largest total size of the cached glyphs
+    std::size_t _size_bytes;                                               //!< total size of the cached glyphs
+    std::list<entry> _entries;                                             //!< cached glyphs, most recently used first
+    std::unordered_map<key, std::list<entry>::iterator, key_hash> _index;  //!< cached glyph of each key
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief scale a glyph and add its effect
+ *
+ * \param character the glyph
+ * \param style the scale and effect
+ * \retval scaled_glyph
+ */
+scaled_glyph scale_glyph(const fonts::glyph& character, text_style style);
+
+};  // namespace graphics
@@ -9,66 +9,88 @@
  */
 
 #include "scrolling_font_renderer.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace graphics {
 
-scrolling_font_renderer::scrolling_font_renderer(const std::vector<fonts::character>& characters,
+scrolling_font_renderer::scrolling_font_renderer(const text_layout& layout,
                                                  uint32_t scroll_rate_ms,
                                                  graphics::origin origin,
-                                                 graphics::color color)
+                                                 graphics::color color,
+                                                 scroll_mode mode,
+                                                 uint16_t loop_gap)
     : shape(origin)
-    , m_characters(characters)
-    , m_shift_rate_ms(scroll_rate_ms)
+    , m_strip_stride(0)
+    , m_strip_width(0)
+    , m_strip_height(layout.extent().height)
+    , m_shift_rate_ms(std::max<uint32_t>(scroll_rate_ms, 1))
     , m_color(color)
+    , m_mode(mode)
     , m_pixel_offset(0)
-    , m_total_message_length(0)
-    , m_last_draw_time(std::chrono::system_clock::now()) {
-    if ( characters.size() > 0 ) {
-        auto ch = characters[0];
-        auto bbox = ch.properties.b_box;
-        m_total_message_length = m_characters.size() * bbox.width;
+    , m_total_message_length(static_cast<uint32_t>(layout.extent().width))
+    , m_start_time(std::chrono::steady_clock::now())
+    , m_drawn(false) {
+    m_strip_width = m_total_message_length + ((mode == scroll_mode::loop) ? loop_gap : 0);
+    m_strip_stride = (m_strip_width + 31) / 32;
+    m_strip.assign(static_cast<size_t>(m_strip_stride) * std::max(m_strip_height, 0), 0);
+
+    //!< render the lit pixels of every character into the strip once
+    const auto& glyphs = layout.glyphs();
+    for ( size_t character_count = 0; character_count < glyphs.size(); character_count++ ) {
+        const auto& glyph = glyphs[character_count];
+        const auto& position = layout.position(character_count);
+        const auto* mask = glyphs.mask(glyph);
+        for ( int j = 0; j < glyph.height; j++ ) {
+            const int row = position.y + j;
+            if ( (row < 0) || (row >= m_strip_height) ) {
+                continue;
+            }
+            for ( int i = 0; i < glyph.width; i++ ) {
+                const int column = position.x + i;
+                if ( mask[j * glyph.width + i] && (column >= 0) && (static_cast<uint32_t>(column) < m_total_message_length) ) {
+                    m_strip[row * m_strip_stride + (column >> 5)] |= 1u << (column & 31);
+                }
+            }
+        }
     }
 }
 
 frame& scrolling_font_renderer::draw(frame& canvas) {
-    auto current_time = std::chrono::system_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - m_last_draw_time);
-    if ( elapsed.count() >= m_shift_rate_ms ) {
-        m_last_draw_time = current_time;
-        const auto width = canvas.width();
-        int x_offset{0};
+    return draw(canvas, std::chrono::steady_clock::now());
+}
 
-        for ( size_t character_count = 0; character_count < m_characters.size(); character_count++ ) {
-            //!< get the current character
-            auto character = m_characters[character_count];
-            auto bbox = character.properties.b_box;
-            auto alignment = (bbox.width % 8 == 0) ? (bbox.width / 8) : (bbox.width / 8) + 1;
-            uint32_t pixel_alignment = alignment << 8ul;
+frame& scrolling_font_renderer::draw(frame& canvas, std::chrono::steady_clock::time_point now) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start_time);
+    const auto offset = static_cast<uint32_t>(std::max<int64_t>(elapsed.count(), 0) / m_shift_rate_ms);
+    if ( !m_drawn || (offset != m_pixel_offset) ) {
+        m_pixel_offset = offset;
+        m_drawn = true;
 
-            //!< draw the character
-            for ( int j = 0; j < character.properties.b_box.height; j++ ) {
-                for ( int i = 0; i < character.properties.b_box.width; i++ ) {
-                    int x = _origin.x + x_offset + i - m_pixel_offset;
-                    auto y = _origin.y + j;
-                    if ( (character.bitmap[j] & (pixel_alignment >> i)) && (x >= _origin.x) ) {                        
-                        canvas.set_pixel(x, y, m_color);
-                    } else {
-                        canvas.set_pixel(x, y, {0, 0, 0});
-                    }
+        //!< clip the window to the frame once so the copy needs no per pixel bounds checks
+        const int right = canvas.width();
+        const int bottom = std::min(canvas.height(), _origin.y + m_strip_height);
+        const bool loop = (m_mode == scroll_mode::loop) && (m_strip_width > 0);
+        const uint32_t start = loop ? (m_pixel_offset % m_strip_width) : m_pixel_offset;
+        const graphics::color off{0, 0, 0};
+
+        for ( int y = _origin.y; y < bottom; y++ ) {
+            const int row = y - _origin.y;
+            uint32_t column = start;
+            for ( int x = _origin.x; x < right; x++ ) {
+                const bool lit = (column < m_strip_width) && strip_pixel(row, column);
+                canvas.set_pixel_unchecked(x, y, lit ? m_color : off);
+                if ( ++column == m_strip_width && loop ) {
+                    column = 0;
                 }
             }
-
-            //!< update the x-draw position for the next character
-            x_offset += bbox.width;
         }
-        m_pixel_offset++;
     }
     return canvas;
 }
 
 bool scrolling_font_renderer::message_completed() const {
-    return (m_pixel_offset == m_total_message_length);
+    return (m_pixel_offset >= m_total_message_length);
 }
 
 };
\ No newline at end of file
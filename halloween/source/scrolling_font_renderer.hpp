@@ -15,48 +15,94 @@
 /********************************** Includes *******************************************/
 #include "font.hpp"
 #include "primatives.hpp"
+#include "text_layout.hpp"
 #include <vector>
 #include <chrono>
 
 namespace graphics
 {
+/**
+ * \brief what happens when the end of the message scrolls past the origin
+ */
+enum class scroll_mode {
+    once,  //!< the message scrolls off and the text rows are left blank
+    loop,  //!< marquee: the message wraps around after a gap and scrolls forever
+};
+
 /**
  * \brief shape type that handles drawing bitmapped fonts
+ * \note the message is rendered once into a packed one bit per pixel strip when the renderer is
+ *       created. Each draw only copies the window of the strip that is on screen, so the cost of a
+ *       frame depends on the panel width and not on the length of the message.
  */
 struct scrolling_font_renderer : public shape {
     /**
      * \brief Construct a new scrolling font renderer object
      * 
-     * \param characters characters to render
-     * \param scroll_rate_ms how fast to scroll the text (time in millseconds per pixel shift)
+     * \param layout the laid out text to render
+     * \param scroll_rate_ms how fast to scroll the text (time in millseconds per pixel shift, at least 1)
      * \param origin the XY coordinates of the message origin, which is where is scrolls into (disappears at)
      * \param color the message color
+     * \param mode scroll the message once or loop it as a marquee
+     * \param loop_gap blank columns between the end of the message and its start in loop mode
      */
-    scrolling_font_renderer(const std::vector<fonts::character>& characters, uint32_t scroll_rate_ms, graphics::origin origin, graphics::color color);
+    scrolling_font_renderer(const text_layout& layout,
+                            uint32_t scroll_rate_ms,
+                            graphics::origin origin,
+                            graphics::color color,
+                            scroll_mode mode = scroll_mode::once,
+                            uint16_t loop_gap = 0);
 
     /**
-     * \brief render a sequence of characters on the screen. Each successive call to draw
-     *        will update the scrolling view if enough time has elapsed.
+     * \brief render a sequence of characters on the screen at the scroll position for the current time
      * 
      * \param canvas existing frame canvas
      * \retval the drawing frame
      */
     frame& draw(frame& canvas);
 
+    /**
+     * \brief render the window of the message at the scroll position for a point in time. The offset is
+     *        the time elapsed since the renderer was created divided by the scroll rate, so the text moves
+     *        at the same speed however often draw is called, and a late frame catches up instead of
+     *        slowing the text down. The frame is only redrawn when the offset changes.
+     * 
+     * \param canvas existing frame canvas
+     * \param now the time of the frame, usually from frame_scheduler::wait
+     * \retval the drawing frame
+     */
+    frame& draw(frame& canvas, std::chrono::steady_clock::time_point now);
+
     /**
      * \brief Helper to check if the image has been drawn completely
      * 
-     * \retval true if the entire message has been printed
+     * \retval true if the entire message has been printed. In loop mode this is after the first lap.
      */
     bool message_completed() const;
 
+    /**
+     * \brief check if a column of the strip has a lit pixel
+     * 
+     * \param row row of the strip
+     * \param column column of the strip
+     * \retval true if the pixel is lit
+     */
+    bool strip_pixel(int row, uint32_t column) const {
+        return (m_strip[row * m_strip_stride + (column >> 5)] >> (column & 31)) & 1;
+    }
+
     //!< Members
-    const std::vector<fonts::character>& m_characters;
+    std::vector<uint32_t> m_strip;  //!< message bitmap, one bit per pixel, rows of m_strip_stride words
+    uint32_t m_strip_stride;        //!< 32 bit words per strip row
+    uint32_t m_strip_width;         //!< columns in the strip: the message, plus the gap in loop mode
+    int m_strip_height;
     uint32_t m_shift_rate_ms;
     graphics::color m_color;
+    scroll_mode m_mode;
     uint32_t m_pixel_offset;
     uint32_t m_total_message_length;
-    std::chrono::time_point<std::chrono::system_clock> m_last_draw_time;
+    std::chrono::steady_clock::time_point m_start_time;  //!< time of offset zero
+    bool m_drawn;                                         //!< false until the first frame is drawn
 };
 
 };  // namespace graphics
\ No newline at end of file
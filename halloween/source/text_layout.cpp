@@ -0,0 +1,118 @@
+/**
+ * \file text_layout.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief places the glyphs of a message once so the font renderers only draw
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "text_layout.hpp"
+#include <algorithm>
+
+namespace graphics
+{
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief vertical metrics of a font
+ */
+struct line_metrics {
+    int height;  //!< height of a line
+    int ascent;  //!< distance from the top of a line to the baseline
+};
+
+/**
+ * \brief get the line metrics of a font from its FONTBOUNDINGBOX and FONT_ASCENT, or from the glyphs of the message if the
+ *        font does not have them
+ *
+ * \param font the font
+ * \param characters the encoded message
+ * \retval line_metrics
+ */
+static line_metrics get_line_metrics(const fonts::font& font, const std::vector<fonts::glyph>& characters) {
+    int top = 0;
+    int bottom = 0;
+    if ( const auto box = font.get_bbox(); box ) {
+        top = box->height + box->y_origin;
+        bottom = box->y_origin;
+    } else {
+        for ( const auto& character : characters ) {
+            const auto& glyph_box = character.properties->b_box;
+            top = std::max(top, glyph_box.height + glyph_box.y_origin);
+            bottom = std::min(bottom, static_cast<int>(glyph_box.y_origin));
+        }
+    }
+    const auto ascent = (font.ascent() > 0) ? font.ascent() : top;
+    return line_metrics{std::max(top - bottom, 1), ascent};
+}
+
+/**
+ * \brief get the right edge of a glyph drawn at a pen position, which is the furthest of its advance and its lit columns
+ *
+ * \param character the glyph
+ * \param pen the pen position
+ * \retval int
+ */
+static int right_edge(const fonts::glyph& character, int pen) {
+    const auto& box = character.properties->b_box;
+    return std::max(pen + character.properties->device_width.first, pen + box.x_origin + box.width);
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new text layout object
+ *
+ * \param font the font the characters were encoded with, for the line metrics
+ * \param characters the encoded message
+ * \param mode the text wrap mode
+ * \param wrap_width width to wrap lines at in wrap mode
+ */
+text_layout::text_layout(const fonts::font& font, const std::vector<fonts::glyph>& characters, text_wrap_mode mode, int wrap_width)
+    : _characters(characters)
+    , _glyphs(characters)
+    , _extent{0, 0} {
+    const auto metrics = get_line_metrics(font, characters);
+    _line_height = metrics.height;
+    _positions.reserve(characters.size());
+
+    int pen = 0;
+    int line = 0;
+    for ( const auto& character : characters ) {
+        const auto& box = character.properties->b_box;
+        const auto advance = character.properties->device_width.first;
+
+        //!< start a new line when the glyph would cross the wrap width, unless it is the first on its line
+        if ( (mode == text_wrap_mode::wrap) && (wrap_width > 0) && (pen > 0) && (right_edge(character, pen) > wrap_width) ) {
+            pen = 0;
+            line++;
+        }
+
+        const auto baseline = line * _line_height + metrics.ascent;
+        _positions.push_back(glyph_position{static_cast<int16_t>(pen + box.x_origin), static_cast<int16_t>(baseline - box.y_origin - box.height)});
+        _extent.width = std::max(_extent.width, right_edge(character, pen));
+        pen += advance;
+    }
+    _extent.height = characters.empty() ? 0 : (line + 1) * _line_height;
+}
+
+/**
+ * \brief measure a message on a single line without laying it out or allocating
+ *
+ * \param font the font the characters were encoded with
+ * \param characters the encoded message
+ * \retval text_extent
+ */
+text_extent text_layout::measure(const fonts::font& font, const std::vector<fonts::glyph>& characters) {
+    int pen = 0;
+    int width = 0;
+    for ( const auto& character : characters ) {
+        width = std::max(width, right_edge(character, pen));
+        pen += character.properties->device_width.first;
+    }
+    return text_extent{width, characters.empty() ? 0 : get_line_metrics(font, characters).height};
+}
+
+};  // namespace graphics
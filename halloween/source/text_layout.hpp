@@ -0,0 +1,139 @@
+/**
+ * \file text_layout.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief places the glyphs of a message once so the font renderers only draw
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "font.hpp"
+#include "glyph_cache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace graphics
+{
+/********************************** Types *******************************************/
+/**
+ * \brief options for handling string wrapping
+ * 
+ */
+enum class text_wrap_mode : unsigned { none = 0, wrap };
+
+/**
+ * \brief size of a block of text in pixels
+ */
+struct text_extent {
+    int width;   //!< widest line, from the pen start to the furthest advance or lit column
+    int height;  //!< number of lines times the line height
+};
+
+/**
+ * \brief position of the top left pixel of a glyph bitmap, relative to the top left of the text
+ */
+struct glyph_position {
+    int16_t x;
+    int16_t y;
+};
+
+/**
+ * \brief the glyphs of a message placed the way the BDF metrics describe: the pen moves by each glyph's DWIDTH, and each
+ *        bitmap is offset from the pen and the baseline by its BBX origin. Lines are FONTBOUNDINGBOX high with the
+ *        baseline FONT_ASCENT below their top. The glyphs are decoded once into a glyph_cache.
+ */
+class text_layout {
+  public:
+    /**
+     * \brief Construct a new text layout object
+     *
+     * \param font the font the characters were encoded with, for the line metrics
+     * \param characters the encoded message
+     * \param mode the text wrap mode
+     * \param wrap_width width to wrap lines at in wrap mode
+     */
+    text_layout(const fonts::font& font,
+                const std::vector<fonts::glyph>& characters,
+                text_wrap_mode mode = text_wrap_mode::none,
+                int wrap_width = 0);
+
+    /**
+     * \brief measure a message on a single line without laying it out or allocating, e.g. to center it
+     *
+     * \param font the font the characters were encoded with
+     * \param characters the encoded message
+     * \retval text_extent
+     */
+    static text_extent measure(const fonts::font& font, const std::vector<fonts::glyph>& characters);
+
+    /**
+     * \brief number of characters in the message
+     *
+     * \retval std::size_t
+     */
+    std::size_t size() const {
+        return _positions.size();
+    }
+
+    /**
+     * \brief get where a character is drawn
+     *
+     * \param index position of the character in the message
+     * \retval const glyph_position&
+     */
+    const glyph_position& position(std::size_t index) const {
+        return _positions[index];
+    }
+
+    /**
+     * \brief get the encoded glyph of a character
+     *
+     * \param index position of the character in the message
+     * \retval const fonts::glyph&
+     */
+    const fonts::glyph& character(std::size_t index) const {
+        return _characters[index];
+    }
+
+    /**
+     * \brief get the decoded glyphs of the message, in the same order as the positions
+     *
+     * \retval const glyph_cache&
+     */
+    const glyph_cache& glyphs() const {
+        return _glyphs;
+    }
+
+    /**
+     * \brief get the size of the laid out text
+     *
+     * \retval text_extent
+     */
+    text_extent extent() const {
+        return _extent;
+    }
+
+    /**
+     * \brief get the height of each line
+     *
+     * \retval int
+     */
+    int line_height() const {
+        return _line_height;
+    }
+
+  private:
+    std::vector<fonts::glyph> _characters;  //!< the encoded message
+    std::vector<glyph_position> _positions;  //!< where each character is drawn
+    glyph_cache _glyphs;                     //!< the message decoded once
+    int _line_height;                        //!< height of each line
+    text_extent _extent;                     //!< size of the laid out text
+};
+
+};  // namespace graphics
@@ -0,0 +1,70 @@
+/**
+ * \file bdf_to_cache.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief converts BDF fonts into the binary font cache format
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "font.hpp"
+#include "font_cache.hpp"
+#include "mapped_file.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief convert one BDF font into a font cache
+ *
+ * \param source_path path of the BDF font
+ * \param cache_path path of the cache to write
+ * \retval true if the cache was written
+ */
+static bool convert(const std::filesystem::path& source_path, const std::filesystem::path& cache_path) {
+    const auto source = mapped_file::open(source_path.string());
+    if ( !source ) {
+        std::cerr << "could not open " << source_path.string() << "\n";
+        return false;
+    }
+    const auto maybe_font = fonts::font::from_buffer(source->view());
+    if ( !maybe_font ) {
+        std::cerr << source_path.string() << ": " << maybe_font.get_error() << "\n";
+        return false;
+    }
+    std::ofstream output{cache_path, std::ios::binary | std::ios::trunc};
+    const auto checksum = fonts::font_cache_checksum(source->data(), source->size());
+    if ( !output || !maybe_font.get_value().write_cache(output, checksum, source->size()) ) {
+        std::cerr << "could not write " << cache_path.string() << "\n";
+        return false;
+    }
+    std::cout << source_path.filename().string() << " -> " << cache_path.string() << " (" << maybe_font.get_value().size() << " glyphs)\n";
+    return true;
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief convert every BDF file given on the command line into a .hfnt cache in the output directory
+ *
+ * usage: bdf_to_cache <output directory> <font.bdf>...
+ */
+int main(int argc, char* argv[]) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: bdf_to_cache <output directory> <font.bdf>...\n";
+        return 1;
+    }
+    const std::filesystem::path output_directory{argv[1]};
+    std::filesystem::create_directories(output_directory);
+    int failures = 0;
+    for ( int arg = 2; arg < argc; arg++ ) {
+        const std::filesystem::path source_path{argv[arg]};
+        const auto cache_path = (output_directory / source_path.filename()).replace_extension(".hfnt");
+        failures += convert(source_path, cache_path) ? 0 : 1;
+    }
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/**
+ * \file bdf_to_header.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief generates a header of constexpr glyph tables from BDF fonts
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "font.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/********************************** Constants *******************************************/
+#define VALUES_PER_LINE (12)  //!< table entries written on each line of the header
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief get the C++ name of a font from its file name, e.g. 7x13B.bdf becomes font_7x13B
+ *
+ * \param path path of the BDF file
+ * \retval std::string
+ */
+static std::string font_name(const std::filesystem::path& path) {
+    auto name = "font_" + path.stem().string();
+    std::replace_if(name.begin(), name.end(), [](unsigned char c) { return !std::isalnum(c); }, '_');
+    return name;
+}
+
+/**
+ * \brief write a list of values as the braced initializer of a std::array
+ *
+ * \param output the output stream
+ * \param values the values
+ * \param per_line values written on each line
+ * \param format writes one value
+ */
+template <typename T, typename Format>
+static void write_array(std::ostream& output, const std::vector<T>& values, std::size_t per_line, Format&& format) {
+    output << "    {{";
+    for ( std::size_t i = 0; i < values.size(); i++ ) {
+        output << (((i % per_line) == 0) ? "\n        " : " ");
+        format(output, values[i]);
+        output << ",";
+    }
+    output << "\n    }},\n";
+}
+
+/**
+ * \brief write the constexpr tables of one font. Only glyphs up to the maximum encoding are kept.
+ *
+ * \param output the output stream
+ * \param path path of the BDF file
+ * \param max_encoding highest encoding to keep
+ * \retval true if the font could be parsed and has glyphs
+ */
+static bool write_font(std::ostream& output, const std::filesystem::path& path, uint16_t max_encoding) {
+    const auto maybe_font = fonts::font::from_file(path.string());
+    if ( !maybe_font ) {
+        std::cerr << path.string() << ": " << maybe_font.get_error() << "\n";
+        return false;
+    }
+    const auto& font = maybe_font.get_value();
+    const auto storage = font.storage();
+    const auto box = font.get_bbox();
+    if ( !box ) {
+        std::cerr << path.string() << ": no bounding box\n";
+        return false;
+    }
+
+    //!< rebuild the table over the kept encodings and only keep the glyphs it refers to
+    std::vector<uint16_t> table;
+    std::vector<fonts::character_properties> properties;
+    std::vector<uint32_t> bitmap_offsets;
+    std::vector<uint32_t> bitmaps;
+    const auto last_encoding = std::min<std::size_t>(font.first_encoding() + storage.table_size, std::size_t{max_encoding} + 1);
+    for ( std::size_t encoding = font.first_encoding(); encoding < last_encoding; encoding++ ) {
+        const auto glyph = font.get_glyph(static_cast<uint16_t>(encoding));
+        if ( !glyph ) {
+            table.push_back(0xFFFF);
+            continue;
+        }
+        table.push_back(static_cast<uint16_t>(properties.size()));
+        properties.push_back(*glyph->properties);
+        bitmap_offsets.push_back(static_cast<uint32_t>(bitmaps.size()));
+        bitmaps.insert(bitmaps.end(), glyph->bitmap, glyph->bitmap + std::max<int>(glyph->properties->b_box.height, 0));
+    }
+    if ( properties.empty() ) {
+        std::cerr << path.string() << ": no glyphs up to encoding " << max_encoding << "\n";
+        return false;
+    }
+
+    //!< fonts where every glyph fills the bounding box can use the fixed size renderer
+    const bool fixed_size = std::all_of(properties.begin(), properties.end(), [&](const auto& glyph) {
+        return (glyph.b_box.width == box->width) && (glyph.b_box.height == box->height);
+    });
+    const int width = fixed_size ? box->width : 0;
+    const int height = fixed_size ? box->height : 0;
+
+    output << "//!< " << path.filename().string() << ", " << properties.size() << " glyphs\n";
+    output << "inline constexpr embedded_font<" << width << ", " << height << ", " << table.size() << ", " << properties.size() << ", "
+           << bitmaps.size() << "> " << font_name(path) << "{\n";
+    output << "    " << font.first_encoding() << ",\n";
+    output << "    bounding_box{" << int{box->width} << ", " << int{box->height} << ", " << int{box->x_origin} << ", " << int{box->y_origin} << "},\n";
+    output << "    " << font.ascent() << ",\n";
+    write_array(output, table, VALUES_PER_LINE, [](std::ostream& out, uint16_t index) { out << index; });
+    write_array(output, properties, 1, [](std::ostream& out, const fonts::character_properties& glyph) {
+        out << "character_properties{" << glyph.encoding << ", {" << glyph.scalable_width.first << ", " << glyph.scalable_width.second
+            << "}, {" << int{glyph.device_width.first} << ", " << int{glyph.device_width.second} << "}, bounding_box{" << int{glyph.b_box.width}
+            << ", " << int{glyph.b_box.height} << ", " << int{glyph.b_box.x_origin} << ", " << int{glyph.b_box.y_origin} << "}}";
+    });
+    write_array(output, bitmap_offsets, VALUES_PER_LINE, [](std::ostream& out, uint32_t offset) { out << offset; });
+    write_array(output, bitmaps, VALUES_PER_LINE, [](std::ostream& out, uint32_t row) { out << "0x" << std::hex << row << std::dec; });
+    output << "};\n\n";
+    std::cout << path.filename().string() << " -> " << font_name(path) << " (" << properties.size() << " glyphs"
+              << (fixed_size ? ", fixed size" : "") << ")\n";
+    return true;
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief write the constexpr glyph tables of every BDF file given on the command line into one header
+ *
+ * usage: bdf_to_header [--max-encoding <n>] <output header> <font.bdf>...
+ */
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    uint16_t max_encoding = 0xFFFE;
+    if ( (argc > 2) && (std::string{argv[arg]} == "--max-encoding") ) {
+        max_encoding = static_cast<uint16_t>(std::min(std::stoul(argv[arg + 1]), 0xFFFEul));
+        arg += 2;
+    }
+    if ( argc - arg < 2 ) {
+        std::cerr << "usage: bdf_to_header [--max-encoding <n>] <output header> <font.bdf>...\n";
+        return 1;
+    }
+    const std::filesystem::path header_path{argv[arg++]};
+
+    std::ostringstream header;
+    header << "/**\n * \\file " << header_path.filename().string() << "\n * \\brief glyph tables generated by tools/font_cache/bdf_to_header, do not edit\n */\n\n";
+    header << "#pragma once\n\n#include \"embedded_font.hpp\"\n\nnamespace fonts\n{\nnamespace embedded\n{\n";
+    int failures = 0;
+    for ( ; arg < argc; arg++ ) {
+        failures += write_font(header, std::filesystem::path{argv[arg]}, max_encoding) ? 0 : 1;
+    }
+    header << "};  // namespace embedded\n};  // namespace fonts\n";
+    if ( failures != 0 ) {
+        return 1;
+    }
+
+    if ( header_path.has_parent_path() ) {
+        std::filesystem::create_directories(header_path.parent_path());
+    }
+    std::ofstream output{header_path, std::ios::trunc};
+    output << header.str();
+    if ( !output ) {
+        std::cerr << "could not write " << header_path.string() << "\n";
+        return 1;
+    }
+    return 0;
+}
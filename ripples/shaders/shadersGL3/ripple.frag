@@ -0,0 +1,10 @@
+#version 150
+
+in float height;
+
+out vec4 output_color;
+
+void main()
+{
+    output_color = vec4(vec3(height), 1.0);
+}
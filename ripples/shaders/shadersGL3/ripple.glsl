@@ -0,0 +1,20 @@
+// ripple model shared by the ripple vertex shader and the verification pass. This matches ripple::get_value on the CPU
+// and the ripple_field pixel layout: pixel (column, row) has its radius measured from the integer origin (width/2, height/2).
+
+uniform float u_time;         // seconds since the impulse
+uniform vec2 u_origin;        // center of the ripple in field pixels
+uniform float u_impulse;
+uniform float u_propagation;
+uniform float u_damping;
+
+// value of the ripple at a field pixel, truncated to the 8-bit steps the CPU path uploads and normalized to [0, 1]
+// like a texture read
+float ripple_value(vec2 pixel)
+{
+    float radius = length(pixel - u_origin);
+    float decay = exp(-u_damping * u_time);
+    float radial_damping = exp(-u_damping * radius);
+    float frequency = u_propagation * (0.5 * cos(u_time * decay) + 0.5);
+    float value = decay * radial_damping * (0.5 * sin(frequency * radius) + 0.5) * u_impulse;
+    return floor(clamp(value, 0.0, 255.0)) / 255.0;
+}
@@ -0,0 +1,27 @@
+#version 150
+
+#pragma include "ripple.glsl"
+
+uniform mat4 modelViewProjectionMatrix;  //!< default name passed by OF
+uniform float u_scale;
+in vec4 position;
+in vec2 texcoord;
+
+out float height;
+
+void main()
+{
+    vec4 modified_position = modelViewProjectionMatrix * position;
+
+    // evaluate the ripple at the texel this vertex would have sampled in the texture path
+    float displacementY = ripple_value(texcoord - vec2(0.5)) * 2;
+
+    // use the displacement to modify the vertex position, the same way as shader.vert
+	modified_position.y += displacementY * u_scale;
+
+    // this is the resulting vertex position
+    gl_Position = modified_position;
+
+    // pass the height to the fragment shader as the color
+    height = displacementY * 0.5;
+}
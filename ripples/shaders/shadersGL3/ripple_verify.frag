@@ -0,0 +1,12 @@
+#version 150
+
+#pragma include "ripple.glsl"
+
+out vec4 output_color;
+
+// write the ripple of every field pixel into a float target so it can be read back and compared against the CPU fill.
+// gl_FragCoord is at the pixel center and row 0 of a read back is the bottom row, so the pixel maps straight through.
+void main()
+{
+    output_color = vec4(ripple_value(gl_FragCoord.xy - vec2(0.5)), 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,9 @@
+#version 150
+
+uniform mat4 modelViewProjectionMatrix;  //!< default name passed by OF
+in vec4 position;
+
+void main()
+{
+    gl_Position = modelViewProjectionMatrix * position;
+}
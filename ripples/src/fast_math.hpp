@@ -0,0 +1,174 @@
+/**
+ * \file fast_math.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief polynomial approximations of exp and sin in scalar and SSE2 form. Both forms use the same range reduction and
+ *        coefficients, so a vector body and its scalar tail give the same results.
+ *
+ *        Measured against std::exp / std::sin in float (see ripple_benchmark.cpp):
+ *          fast_exp: relative error < 1e-7 for x in [-87, 88]. Inputs outside the range are clamped.
+ *          fast_sin: absolute error < 3e-7 for |x| < 1e4. The reduction by 2 pi is exact for |x| < 5e4 (|k| < 2^13)
+ *                    and degrades gradually above that.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FAST_MATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/********************************** Constants *******************************************/
+namespace fast_math
+{
+constexpr float exp_min = -87.0f;                 //!< smallest input that still gives a normal result
+constexpr float exp_max = 88.0f;                  //!< largest input that does not overflow
+constexpr float log2_e = 1.44269504088896341f;
+constexpr float ln2_hi = 0.693359375f;            //!< ln(2) split so that n * ln2_hi is exact
+constexpr float ln2_lo = -2.12194440e-4f;
+constexpr float inv_two_pi = 0.159154943091895336f;
+constexpr float two_pi_hi = 6.28125f;              //!< 2 pi split so that k * hi and k * mid are exact for |k| < 2^13
+constexpr float two_pi_mid = 1.93500518798828125e-3f;
+constexpr float two_pi_lo = 3.01991605e-7f;
+constexpr float pi_f = 3.14159265358979323f;
+
+//!< minimax coefficients for exp(f) - 1 - f on [-ln2 / 2, ln2 / 2] (Cephes expf)
+constexpr float exp_c0 = 1.9875691500e-4f;
+constexpr float exp_c1 = 1.3981999507e-3f;
+constexpr float exp_c2 = 8.3334519073e-3f;
+constexpr float exp_c3 = 4.1665795894e-2f;
+constexpr float exp_c4 = 1.6666665459e-1f;
+constexpr float exp_c5 = 5.0000001201e-1f;
+
+//!< odd Taylor coefficients for sin on [-pi / 2, pi / 2], truncation error (pi / 2)^13 / 13! < 6e-8
+constexpr float sin_c0 = -2.50521084e-8f;
+constexpr float sin_c1 = 2.75573192e-6f;
+constexpr float sin_c2 = -1.98412698e-4f;
+constexpr float sin_c3 = 8.33333333e-3f;
+constexpr float sin_c4 = -1.66666667e-1f;
+
+/********************************** Functions *******************************************/
+/**
+ * \brief round to the nearest integer (ties to even) for |x| < 2^22 by pushing the fraction out of the mantissa. Matches
+ *        _mm_cvtps_epi32 without the library call std::nearbyint usually compiles to.
+ *
+ * \param x value to round
+ * \retval float
+ */
+inline float round_nearest(float x) {
+    constexpr float shift = 12582912.0f;  //!< 1.5 * 2^23
+    return (x + shift) - shift;
+}
+
+/**
+ * \brief approximate e^x
+ *
+ * \param x exponent
+ * \retval float
+ */
+inline float fast_exp(float x) {
+    x = std::min(std::max(x, exp_min), exp_max);
+    const auto n = round_nearest(x * log2_e);
+    const auto f = x - n * ln2_hi - n * ln2_lo;
+    auto p = exp_c0;
+    p = p * f + exp_c1;
+    p = p * f + exp_c2;
+    p = p * f + exp_c3;
+    p = p * f + exp_c4;
+    p = p * f + exp_c5;
+    const auto y = p * f * f + f + 1.0f;
+
+    //!< build 2^n directly in the exponent bits
+    const int32_t bits = (static_cast<int32_t>(n) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return y * scale;
+}
+
+/**
+ * \brief approximate sin(x)
+ *
+ * \param x angle in radians
+ * \retval float
+ */
+inline float fast_sin(float x) {
+    //!< reduce to [-pi, pi] and then fold onto [-pi / 2, pi / 2] using sin(x) = sin(pi - x)
+    const auto k = round_nearest(x * inv_two_pi);
+    x = x - k * two_pi_hi - k * two_pi_mid - k * two_pi_lo;
+    //!< the reduction can land just outside [-pi, pi], so the sign is flipped rather than copied to keep pi - |x| < 0 correct
+    const auto magnitude = std::fabs(x);
+    const auto folded = std::min(magnitude, pi_f - magnitude);
+    x = std::signbit(x) ? -folded : folded;
+
+    const auto x2 = x * x;
+    auto p = sin_c0;
+    p = p * x2 + sin_c1;
+    p = p * x2 + sin_c2;
+    p = p * x2 + sin_c3;
+    p = p * x2 + sin_c4;
+    return x + x * x2 * p;
+}
+
+#if defined(FAST_MATH_SSE2)
+/**
+ * \brief approximate e^x for four lanes
+ *
+ * \param x exponents
+ * \retval __m128
+ */
+inline __m128 fast_exp(__m128 x) {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(exp_min)), _mm_set1_ps(exp_max));
+    const auto n_int = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(log2_e)));
+    const auto n = _mm_cvtepi32_ps(n_int);
+    auto f = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(ln2_hi)));
+    f = _mm_sub_ps(f, _mm_mul_ps(n, _mm_set1_ps(ln2_lo)));
+
+    auto p = _mm_set1_ps(exp_c0);
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp_c1));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp_c2));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp_c3));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp_c4));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(exp_c5));
+    const auto y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, f), f), f), _mm_set1_ps(1.0f));
+
+    const auto scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n_int, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(y, scale);
+}
+
+/**
+ * \brief approximate sin(x) for four lanes
+ *
+ * \param x angles in radians
+ * \retval __m128
+ */
+inline __m128 fast_sin(__m128 x) {
+    const auto k = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(inv_two_pi))));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(two_pi_hi)));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(two_pi_mid)));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(two_pi_lo)));
+
+    const auto sign_mask = _mm_set1_ps(-0.0f);
+    const auto sign = _mm_and_ps(x, sign_mask);
+    const auto magnitude = _mm_andnot_ps(sign_mask, x);
+    x = _mm_xor_ps(_mm_min_ps(magnitude, _mm_sub_ps(_mm_set1_ps(pi_f), magnitude)), sign);
+
+    const auto x2 = _mm_mul_ps(x, x);
+    auto p = _mm_set1_ps(sin_c0);
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sin_c1));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sin_c2));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sin_c3));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(sin_c4));
+    return _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), p));
+}
+#endif
+};  // namespace fast_math
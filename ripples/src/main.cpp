@@ -12,21 +12,48 @@
 /********************************** Includes *******************************************/
 #include "ofMain.h"
 #include "ofApp.h"
+#include "async_readback.hpp"
+#include "headless_runner.hpp"
+#include "ripple_benchmark.hpp"
+#include "ripple_engine.hpp"
+#include "ripple_options.hpp"
+#include "sketch_options.hpp"
 #include <memory>
+#include <optional>
+#include <utility>
 
 /********************************** Function Definitions *******************************************/
 /**
- * \brief main application startup function
+ * \brief main application startup function. Pass --headless to run the ripple simulation without a window
+ *        (see sketch_options.hpp and ripple_options.hpp for the full set of flags).
  * 
  * \param argc number of CLI arguments
  * \param argv list of arguments
  * \retval int 
  */
 int main(int argc, char* argv[] ){
+    const auto options = parse_sketch_options(argc, argv);
+    const auto ripples = parse_ripple_options(argc, argv);
+    if ( ripples.benchmark ) {
+        return run_ripple_benchmark(ripples);
+    }
+    const bool shader_pipeline = (ripples.shader || ripples.verify_shader) && !options.headless;
+    std::optional<ripple_engine> engine;
+    if ( !shader_pipeline ) {
+        engine = make_ripple_engine(ripples);
+        if ( !engine ) {
+            return 1;
+        }
+        if ( options.headless ) {
+            return run_headless(*engine, options, of_image_encoder());
+        }
+    }
+
     ofGLWindowSettings window_settings;
     window_settings.setGLVersion(3, 2);
     window_settings.setSize(1600, 1200);
     ofCreateWindow(window_settings);
-    auto app = std::make_unique<application>(160, 160);
-    ofRunApp(app.get());
+    auto app = shader_pipeline ? std::make_unique<application>(ripples, options)
+                               : std::make_unique<application>(std::move(*engine), options);
+    return ofRunApp(app.get());
 }
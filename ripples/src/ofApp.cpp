@@ -11,51 +11,48 @@
 
 /********************************** Includes *******************************************/
 #include "ofApp.h"
+#include "profiler_overlay.hpp"
 #include "ripple.hpp"
-#include <filesystem>
-#include <cmath>
-#include <cstdlib>
+#include <utility>
 
 
 /********************************** Function Definitions *******************************************/
 /**
- * \brief generic function to turn calculate the radius of a cartesian point
+ * \brief Construct a new application::application object
  * 
- * \tparam T type of the points x and y
- * \param x coordinate
- * \param y coordinate
- * \retval return type deduced based on arguments
+ * \param engine the ripple engine to render
+ * \param options sketch options for the clock, threading and profiler
  */
-template <typename T>
-auto calculate_radius(T&& x, T&& y) {
-    return std::sqrt(std::pow(x, 2.0) + std::pow(y, 2.0));
-}
-
+application::application(ripple_engine&& engine, const sketch_options& options) 
+: _view(std::in_place, std::move(engine), heightfield_settings{}, options)
+, _clock(options.make_clock()) { }
 
 /**
- * \brief Construct a new application::application object
+ * \brief Construct a new application::application object that evaluates the ripple in the vertex shader, or only verifies
+ *        the shader against the CPU field when --verify-shader is passed
  * 
- * \param width width of the wireframe in grid tiles
- * \param height height of the wireframe in grid tiles
+ * \param ripples ripple options for the field size and shader mode
+ * \param options sketch options for the clock and profiler
  */
-application::application(int width, int height) 
-: _width(width)
-, _height(height) {
-    _x_origin = width / 2;
-    _y_origin = height / 2;
-    _image.allocate(height, width, OF_IMAGE_GRAYSCALE);
-    _plane.set(1200, 900, width, height, OF_PRIMITIVE_TRIANGLES);
-    _plane.mapTexCoordsFromTexture(_image.getTexture());
+application::application(const ripple_options& ripples, const sketch_options& options) 
+: _ripples(ripples)
+, _clock(options.make_clock()) {
+    if ( !ripples.verify_shader ) {
+        _shader_view.emplace(ripple{255, 1, 0.1}, ripples.field_size, ripples.field_size, heightfield_settings{}, options);
+    }
 }
 
 /**
  * \brief setup function to load shaders and other objects
  */
 void application::setup() { 
-    auto path = std::filesystem::current_path();
-    auto parent_path = path.parent_path();
-    std::filesystem::path shader_path = parent_path / std::filesystem::path{"shaders"};
-    _displacement_shader.load(shader_path / std::filesystem::path{"shadersGL3/shader"});    
+    if ( _view ) {
+        _view->setup();
+    } else if ( _shader_view ) {
+        _shader_view->setup();
+    } else {
+        ofExit(verify_ripple_shader(_ripples));
+    }
 }
 
 
@@ -63,22 +60,12 @@ void application::setup() {
  * \brief update method to draw a new frame
  */
 void application::update() {     
-    auto time = ofGetElapsedTimef();
-
-    ofPixels& pixels = _image.getPixels();
-    const auto width = _image.getWidth();
-    const auto height = _image.getHeight();
-    ripple wave{255, 1, 0.1};    
-     
-    for ( uint64_t row = 0; row < height; row++ ) {
-        for ( uint64_t column = 0; column < width; column++ ) {
-            uint64_t x = std::llabs(column - _x_origin);
-            uint64_t y = std::llabs(row - _y_origin);
-            auto r = calculate_radius(x, y);
-            pixels[row * static_cast<int>(width) + column] = ofClamp(wave.get_value(r, time), 0, 255);
-        }
+    const auto time_sec = _clock.tick();
+    if ( _view ) {
+        _view->update(time_sec);
+    } else if ( _shader_view ) {
+        _shader_view->update(time_sec);
     }
-    _image.update();    
 }
 
 
@@ -86,40 +73,68 @@ void application::update() {
  * \brief renders the image to the screen
  */
 void application::draw() { 
-    //!< bind the texture to the shader
-    _image.getTexture().bind();    
-
-    //!< start the shader
-    _displacement_shader.begin();    
+    if ( _view ) {
+        _view->draw(200);
+    } else if ( _shader_view ) {
+        _shader_view->draw(200);
+    }
+}
 
-    _displacement_shader.setUniform1f("u_scale", 200);
 
-    //!< push the current local coordinate system to move to a new relative one
-    ofPushMatrix();
+/**
+ * \brief finish any recording and dump recorded profiler samples when the application closes
+ */
+void application::exit() {
+    if ( _view ) {
+        _view->finish_recording();
+        dump_profiler(_view->profiler(), "ripples_profile");
+    } else if ( _shader_view ) {
+        dump_profiler(_shader_view->profiler(), "ripples_profile");
+    }
+}
 
-    //!< translate the plane into the center of the screen
-    auto center_x = ofGetWidth() / 2.0;
-    auto center_y = ofGetHeight() / 2.0;
-    ofTranslate(center_x, center_y);
 
-    //!< rotate it to a more isometric view
-    auto rotation = ofMap(0.30, 0, 1, -60, 60, true) + 60;
-    ofRotateDeg(rotation, 1, 0, 0);
+/**
+ * \brief key handler. 'p' toggles the frame profiler and its overlay, 'r' pauses and resumes recording
+ * 
+ * \param key the key that was pressed
+ */
+void application::keyPressed(int key) {
+    if ( key == 'p' ) {
+        auto& profiler = _view ? _view->profiler() : _shader_view->profiler();
+        profiler.set_enabled(!profiler.enabled());
+    } else if ( (key == 'r') && _view ) {
+        _view->toggle_recording();
+    }
+}
 
-    //!< draw the wireframe
-    _plane.drawWireframe();
 
-    ofPopMatrix();
-    _displacement_shader.end();
+/**
+ * \brief spawn a ripple where the click lands on the field. In wave equation mode a right click places an obstacle instead.
+ *        Clicks are ignored in shader mode, which only draws the centered ripple.
+ * 
+ * \param x mouse x position
+ * \param y mouse y position
+ * \param button the button that was pressed
+ */
+void application::mousePressed(int x, int y, int button) {
+    if ( !_view ) {
+        return;
+    }
+    if ( auto point = _view->screen_to_field(x, y) ) {
+        if ( button == OF_MOUSE_BUTTON_RIGHT ) {
+            _view->engine().add_obstacle(point->x, point->y, 8.0f);
+        } else {
+            _view->engine().spawn(point->x, point->y, ripple{255, 1, 0.1});
+        }
+    }
 }
 
 
 /********************************** Unused Openframeworks API Functions *******************************************/
-void application::keyPressed(int key) { }
 void application::keyReleased(int key) { }
 void application::mouseMoved(int x, int y) { }
 void application::mouseDragged(int x, int y, int button) { }
-void application::mousePressed(int x, int y, int button) { }
 void application::mouseReleased(int x, int y, int button) { }
 void application::mouseEntered(int x, int y) { }
 void application::mouseExited(int x, int y) { }
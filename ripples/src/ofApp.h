@@ -13,15 +13,24 @@
 
 /********************************** Includes *******************************************/
 #include "ofMain.h"
+#include "heightfield_view.hpp"
+#include "ripple_engine.hpp"
+#include "ripple_options.hpp"
+#include "ripple_shader_view.hpp"
+#include "simulation_clock.hpp"
+#include "sketch_options.hpp"
+#include <optional>
 
 /********************************** Types *******************************************/
 class application : public ofBaseApp {
   public:
-    application(int width, int height);
+    application(ripple_engine&& engine, const sketch_options& options = sketch_options{});
+    application(const ripple_options& ripples, const sketch_options& options = sketch_options{});
 
     void setup();
     void update();
     void draw();
+    void exit();
 
     //!< open frameworks base application interface functions
     void keyPressed(int key);
@@ -37,11 +46,8 @@ class application : public ofBaseApp {
     void gotMessage(ofMessage msg);
 
   private:
-    ofShader _displacement_shader;
-    ofPlanePrimitive _plane;
-    ofImage _image;    
-    int _width;
-    int _height;
-    int _x_origin;
-    int _y_origin;
+    std::optional<heightfield_view<ripple_engine>> _view;  //!< CPU field and texture upload
+    std::optional<ripple_shader_view> _shader_view;       //!< ripple evaluated in the vertex shader
+    ripple_options _ripples;
+    simulation_clock _clock;
 };
@@ -0,0 +1,114 @@
+/**
+ * \file radial_profile.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief per-frame lookup table of a radially symmetric ripple
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "radial_profile.hpp"
+#include "ripple_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+/********************************** Constants *******************************************/
+constexpr std::size_t minimum_bins = 2;
+constexpr std::size_t maximum_bins = 1 << 20;
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new radial profile object sized so that interpolation stays within a tolerance
+ *
+ * \param wave the ripple model
+ * \param max_radius largest radius that will be looked up
+ * \param tolerance maximum interpolation error in output units (8-bit steps)
+ */
+radial_profile::radial_profile(const ripple& wave, float max_radius, float tolerance) {
+    const auto bins = bins_for(wave, max_radius, tolerance);
+    _bin_width = std::max(max_radius, 1.0f) / static_cast<float>(bins - 1);
+    _inverse_bin_width = 1.0f / _bin_width;
+    _values.resize(bins + 1, 0.0f);
+}
+
+/**
+ * \brief the number of bins needed to interpolate a ripple within a tolerance
+ *
+ * \param wave the ripple model
+ * \param max_radius largest radius that will be looked up
+ * \param tolerance maximum interpolation error in output units
+ * \retval std::size_t number of bins
+ */
+std::size_t radial_profile::bins_for(const ripple& wave, float max_radius, float tolerance) {
+    const auto d = std::fabs(wave.damping);
+    const auto w = std::fabs(wave.propagation);
+    const auto curvature = std::fabs(wave.impulse) * (d * d + d * w + 0.5f * w * w);
+    if ( (curvature <= 0.0f) || (tolerance <= 0.0f) ) {
+        return (curvature <= 0.0f) ? minimum_bins : maximum_bins;
+    }
+    const auto bin_width = std::sqrt(8.0f * tolerance / curvature);
+    const auto bins = static_cast<std::size_t>(std::ceil(std::max(max_radius, 1.0f) / bin_width)) + 1;
+    return std::clamp(bins, minimum_bins, maximum_bins);
+}
+
+/**
+ * \brief evaluate the ripple at every bin for a point in time
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ */
+void radial_profile::update(const ripple& wave, float time_sec) {
+    for ( std::size_t bin = 0; bin < _values.size(); bin++ ) {
+        _values[bin] = wave.get_value(static_cast<float>(bin) * _bin_width, time_sec);
+    }
+}
+
+/**
+ * \brief interpolate the table at each radius and write 8-bit pixels clamped to [0, 255]
+ *
+ * \param radii radius of each pixel, no larger than the max radius
+ * \param pixels output pixels
+ * \param count number of pixels
+ */
+void radial_profile::fill(const float* radii, uint8_t* pixels, std::size_t count) const {
+    const auto* values = _values.data();
+    const auto last_bin = static_cast<int32_t>(_values.size() - 2);
+    std::size_t i = 0;
+#if defined(FAST_MATH_SSE2)
+    //!< positions and interpolation are vectorized, the table reads are four scalar loads since SSE2 has no gather
+    const auto inverse_bin_width = _mm_set1_ps(_inverse_bin_width);
+    const auto max_bin = _mm_set1_epi32(last_bin);
+    for ( ; i + 4 <= count; i += 4 ) {
+        const auto position = _mm_mul_ps(_mm_loadu_ps(radii + i), inverse_bin_width);
+        auto bin = _mm_cvttps_epi32(position);
+        const auto over = _mm_cmpgt_epi32(bin, max_bin);
+        bin = _mm_or_si128(_mm_and_si128(over, max_bin), _mm_andnot_si128(over, bin));
+        const auto fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(bin));
+
+        alignas(16) int32_t bins[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bins), bin);
+        const auto low = _mm_setr_ps(values[bins[0]], values[bins[1]], values[bins[2]], values[bins[3]]);
+        const auto high = _mm_setr_ps(values[bins[0] + 1], values[bins[1] + 1], values[bins[2] + 1], values[bins[3] + 1]);
+        store_pixels(pixels + i, _mm_add_ps(low, _mm_mul_ps(fraction, _mm_sub_ps(high, low))));
+    }
+#endif
+    for ( ; i < count; i++ ) {
+        const auto position = radii[i] * _inverse_bin_width;
+        const auto bin = std::min(static_cast<int32_t>(position), last_bin);
+        const auto fraction = position - static_cast<float>(bin);
+        const auto value = values[bin] + fraction * (values[bin + 1] - values[bin]);
+        pixels[i] = to_pixel(value);
+    }
+}
+
+/**
+ * \brief get the number of bins in the table
+ *
+ * \retval std::size_t
+ */
+std::size_t radial_profile::bins() const {
+    return _values.size() - 1;
+}
@@ -0,0 +1,71 @@
+/**
+ * \file radial_profile.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief per-frame lookup table of a radially symmetric ripple. The model is evaluated once per frame at evenly spaced radii
+ *        and each pixel linearly interpolates the table at its precomputed radius.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ripple.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief radial profile lookup table
+ */
+class radial_profile {
+  public:
+    /**
+     * \brief Construct a new radial profile object sized so that interpolation stays within a tolerance
+     *
+     * \param wave the ripple model
+     * \param max_radius largest radius that will be looked up
+     * \param tolerance maximum interpolation error in output units (8-bit steps)
+     */
+    radial_profile(const ripple& wave, float max_radius, float tolerance);
+
+    /**
+     * \brief the number of bins needed to interpolate a ripple within a tolerance. Linear interpolation with bin width h is
+     *        off by at most h^2 / 8 * max|f''|. For f = A e^(-d r) (0.5 sin(w r) + 0.5) with w <= propagation,
+     *        |f''| <= A (d^2 + d w + w^2 / 2) at every point in time.
+     *
+     * \param wave the ripple model
+     * \param max_radius largest radius that will be looked up
+     * \param tolerance maximum interpolation error in output units
+     * \retval std::size_t number of bins
+     */
+    static std::size_t bins_for(const ripple& wave, float max_radius, float tolerance);
+
+    /**
+     * \brief evaluate the ripple at every bin for a point in time
+     *
+     * \param wave the ripple model
+     * \param time_sec time since the initial impulse
+     */
+    void update(const ripple& wave, float time_sec);
+
+    /**
+     * \brief interpolate the table at each radius and write 8-bit pixels clamped to [0, 255]
+     *
+     * \param radii radius of each pixel, no larger than the max radius
+     * \param pixels output pixels
+     * \param count number of pixels
+     */
+    void fill(const float* radii, uint8_t* pixels, std::size_t count) const;
+
+    std::size_t bins() const;
+
+  private:
+    float _bin_width;
+    float _inverse_bin_width;
+    std::vector<float> _values;  //!< one extra bin past the max radius so interpolation never reads out of range
+};
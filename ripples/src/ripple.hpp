@@ -68,14 +68,14 @@ struct ripple {
      * \param time_sec time since the initial impulse
      * \retval float ripple output
      */
-    float get_value(float radius, float time_sec) {                
+    float get_value(float radius, float time_sec) const {                
         auto decay = std::exp(-damping * time_sec);
         auto radial_damping = std::exp(-damping * radius);
         return decay * radial_damping * normalized_sin(propagation * radius * normalized_cos(time_sec * decay)) * impulse;
     }
 
     //!< Parameters
+    float impulse;
     float propagation;
     float damping;
-    float impulse;
 };
@@ -0,0 +1,83 @@
+/**
+ * \file ripple_batch.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief evaluates a ripple over a whole row or field of radii for a single point in time using the vectorized
+ *        approximations in fast_math.hpp
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_batch.hpp"
+#include <cmath>
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief evaluate a ripple for a batch of radii
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param values output value of each sample
+ * \param count number of samples
+ */
+void evaluate_ripple_batch(const ripple& wave, float time_sec, const float* radii, float* values, std::size_t count) {
+    const ripple_terms terms{wave, time_sec};
+    std::size_t i = 0;
+#if defined(FAST_MATH_SSE2)
+    for ( ; i + 4 <= count; i += 4 ) {
+        _mm_storeu_ps(values + i, terms.evaluate(_mm_loadu_ps(radii + i)));
+    }
+#endif
+    for ( ; i < count; i++ ) {
+        values[i] = terms.evaluate(radii[i]);
+    }
+}
+
+/**
+ * \brief evaluate a ripple for a batch of radii and write the results as 8-bit pixels clamped to [0, 255]
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param pixels output pixels
+ * \param count number of samples
+ */
+void fill_ripple_batch(const ripple& wave, float time_sec, const float* radii, uint8_t* pixels, std::size_t count) {
+    const ripple_terms terms{wave, time_sec};
+    std::size_t i = 0;
+#if defined(FAST_MATH_SSE2)
+    for ( ; i + 4 <= count; i += 4 ) {
+        store_pixels(pixels + i, terms.evaluate(_mm_loadu_ps(radii + i)));
+    }
+#endif
+    for ( ; i < count; i++ ) {
+        pixels[i] = to_pixel(terms.evaluate(radii[i]));
+    }
+}
+
+/**
+ * \brief evaluate a ripple for a batch of samples with precomputed radial damping
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param radial_damping exp(-wave.damping * radius) of each sample
+ * \param pixels output pixels
+ * \param count number of samples
+ */
+void fill_ripple_batch(const ripple& wave, float time_sec, const float* radii, const float* radial_damping, uint8_t* pixels, std::size_t count) {
+    const ripple_terms terms{wave, time_sec};
+    std::size_t i = 0;
+#if defined(FAST_MATH_SSE2)
+    for ( ; i + 4 <= count; i += 4 ) {
+        store_pixels(pixels + i, terms.evaluate(_mm_loadu_ps(radii + i), _mm_loadu_ps(radial_damping + i)));
+    }
+#endif
+    for ( ; i < count; i++ ) {
+        pixels[i] = to_pixel(terms.evaluate(radii[i], radial_damping[i]));
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * \file ripple_batch.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief evaluates a ripple over a whole row or field of radii for a single point in time using the vectorized
+ *        approximations in fast_math.hpp
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "fast_math.hpp"
+#include "ripple.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/********************************** Types *******************************************/
+/**
+ * \brief the terms of ripple::get_value that only depend on time, computed once per batch (or once per source per frame)
+ */
+struct ripple_terms {
+    ripple_terms(const ripple& wave, float time_sec) {
+        const auto decay = std::exp(-wave.damping * time_sec);
+        amplitude = decay * wave.impulse;
+        frequency = wave.propagation * static_cast<float>(normalized_cos(time_sec * decay));
+        radial_rate = -wave.damping;
+    }
+
+    /**
+     * \brief evaluate the ripple at a single radius
+     *
+     * \param radius the radius
+     * \retval float
+     */
+    float evaluate(float radius) const {
+        return evaluate(radius, fast_math::fast_exp(radial_rate * radius));
+    }
+
+    /**
+     * \brief evaluate the ripple at a single radius with a precomputed radial damping
+     *
+     * \param radius the radius
+     * \param radial_damping exp(-damping * radius)
+     * \retval float
+     */
+    float evaluate(float radius, float radial_damping) const {
+        return amplitude * radial_damping * (0.5f * fast_math::fast_sin(frequency * radius) + 0.5f);
+    }
+
+#if defined(FAST_MATH_SSE2)
+    /**
+     * \brief evaluate the ripple at four radii
+     *
+     * \param radius the radii
+     * \retval __m128
+     */
+    __m128 evaluate(__m128 radius) const {
+        return evaluate(radius, fast_math::fast_exp(_mm_mul_ps(_mm_set1_ps(radial_rate), radius)));
+    }
+
+    /**
+     * \brief evaluate the ripple at four radii with precomputed radial damping
+     *
+     * \param radius the radii
+     * \param radial_damping exp(-damping * radius)
+     * \retval __m128
+     */
+    __m128 evaluate(__m128 radius, __m128 radial_damping) const {
+        const auto half = _mm_set1_ps(0.5f);
+        const auto wave = _mm_add_ps(_mm_mul_ps(half, fast_math::fast_sin(_mm_mul_ps(_mm_set1_ps(frequency), radius))), half);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(amplitude), radial_damping), wave);
+    }
+#endif
+
+    float amplitude;    //!< impulse * exp(-damping * t)
+    float frequency;    //!< propagation * normalized_cos(t * decay)
+    float radial_rate;  //!< -damping
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief clamp a value to [0, 255] and truncate it to a pixel, matching the scalar model
+ *
+ * \param value ripple value
+ * \retval uint8_t
+ */
+inline uint8_t to_pixel(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f));
+}
+
+#if defined(FAST_MATH_SSE2)
+/**
+ * \brief clamp, truncate and store four values as pixels
+ *
+ * \param pixels output for four pixels
+ * \param value ripple values
+ */
+inline void store_pixels(uint8_t* pixels, __m128 value) {
+    //!< clamp, truncate like the scalar cast, then narrow 32 -> 16 -> 8 bits
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    const auto words = _mm_packs_epi32(_mm_cvttps_epi32(value), _mm_setzero_si128());
+    const auto bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, _mm_setzero_si128()));
+    std::memcpy(pixels, &bytes, sizeof(bytes));
+}
+#endif
+
+/**
+ * \brief evaluate a ripple for a batch of radii. Matches ripple::get_value to within the fast_math error bounds, which is
+ *        below 1e-3 for an impulse of 255 (less than a single 8-bit step).
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param values output value of each sample
+ * \param count number of samples
+ */
+void evaluate_ripple_batch(const ripple& wave, float time_sec, const float* radii, float* values, std::size_t count);
+
+/**
+ * \brief evaluate a ripple for a batch of radii and write the results as 8-bit pixels clamped to [0, 255]
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param pixels output pixels
+ * \param count number of samples
+ */
+void fill_ripple_batch(const ripple& wave, float time_sec, const float* radii, uint8_t* pixels, std::size_t count);
+
+/**
+ * \brief evaluate a ripple for a batch of samples whose radial damping exp(-damping * radius) has been precomputed, leaving
+ *        only the time dependent sin per sample
+ *
+ * \param wave the ripple model
+ * \param time_sec time since the initial impulse
+ * \param radii radius of each sample
+ * \param radial_damping exp(-wave.damping * radius) of each sample
+ * \param pixels output pixels
+ * \param count number of samples
+ */
+void fill_ripple_batch(const ripple& wave, float time_sec, const float* radii, const float* radial_damping, uint8_t* pixels, std::size_t count);
@@ -0,0 +1,179 @@
+/**
+ * \file ripple_benchmark.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief microbenchmark comparing the scalar ripple model against the batch evaluation for speed and accuracy
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_benchmark.hpp"
+#include "fast_math.hpp"
+#include "radial_profile.hpp"
+#include "ripple.hpp"
+#include "ripple_batch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief time a function that evaluates one frame
+ *
+ * \tparam Function callable taking the frame time in seconds
+ * \param iterations number of frames
+ * \param function the frame function
+ * \retval double average milliseconds per frame
+ */
+template <typename Function>
+static double time_frames(uint64_t iterations, Function&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    for ( uint64_t frame = 0; frame < iterations; frame++ ) {
+        function(static_cast<float>(frame) / 60.0f);
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return (iterations > 0) ? elapsed / iterations : 0.0;
+}
+
+/**
+ * \brief sweep the fast_math approximations against the standard library
+ *
+ * \param exp_error maximum relative error of fast_exp on [-87, 88]
+ * \param sin_error maximum absolute error of fast_sin on [-1e4, 1e4]
+ */
+static void measure_approximations(double& exp_error, double& sin_error) {
+    constexpr int samples = 1 << 22;
+    std::vector<float> inputs(samples);
+
+    exp_error = 0;
+    for ( int i = 0; i < samples; i++ ) {
+        inputs[i] = fast_math::exp_min + (fast_math::exp_max - fast_math::exp_min) * static_cast<float>(i) / (samples - 1);
+    }
+    for ( int i = 0; i < samples; i++ ) {
+        const auto reference = std::exp(static_cast<double>(inputs[i]));
+        exp_error = std::max(exp_error, std::fabs(fast_math::fast_exp(inputs[i]) - reference) / reference);
+    }
+
+    sin_error = 0;
+    for ( int i = 0; i < samples; i++ ) {
+        inputs[i] = -1e4f + 2e4f * static_cast<float>(i) / (samples - 1);
+    }
+    for ( int i = 0; i < samples; i++ ) {
+        sin_error = std::max(sin_error, std::fabs(fast_math::fast_sin(inputs[i]) - std::sin(static_cast<double>(inputs[i]))));
+    }
+}
+
+/**
+ * \brief compare 8-bit output against the scalar model
+ *
+ * \param reference scalar model pixels
+ * \param pixels pixels to check
+ * \param max_error largest difference seen so far, in 8-bit steps
+ * \param differing number of differing pixels seen so far
+ */
+static void compare_pixels(const std::vector<uint8_t>& reference, const std::vector<uint8_t>& pixels, int& max_error, uint64_t& differing) {
+    for ( std::size_t i = 0; i < reference.size(); i++ ) {
+        const auto difference = std::abs(static_cast<int>(pixels[i]) - static_cast<int>(reference[i]));
+        max_error = std::max(max_error, difference);
+        differing += (difference != 0) ? 1 : 0;
+    }
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief time the scalar, batch, precomputed geometry and radial profile paths over a field and report the speedups and the
+ *        maximum errors of the batch and radial profile output
+ *
+ * \param options field size, iteration count and lookup table tolerance
+ * \retval int process return value
+ */
+int run_ripple_benchmark(const ripple_options& options) {
+    const ripple wave{255, 1, 0.1};
+    const auto width = options.field_size;
+    const auto height = options.field_size;
+    const auto iterations = options.iterations;
+    const auto count = width * height;
+    std::vector<float> radii(count);
+    std::vector<float> radial_damping(count);
+    for ( std::size_t row = 0; row < height; row++ ) {
+        for ( std::size_t column = 0; column < width; column++ ) {
+            const auto x = static_cast<double>(column) - static_cast<double>(width / 2);
+            const auto y = static_cast<double>(row) - static_cast<double>(height / 2);
+            radii[row * width + column] = static_cast<float>(std::sqrt(x * x + y * y));
+            radial_damping[row * width + column] = std::exp(-wave.damping * radii[row * width + column]);
+        }
+    }
+    const auto max_radius = radii.empty() ? 0.0f : *std::max_element(radii.begin(), radii.end());
+    radial_profile profile{wave, max_radius, options.lut_tolerance};
+
+    std::vector<uint8_t> scalar_pixels(count);
+    std::vector<uint8_t> batch_pixels(count);
+    std::vector<uint8_t> profile_pixels(count);
+    const auto scalar_ms = time_frames(iterations, [&](float time_sec) {
+        for ( std::size_t i = 0; i < count; i++ ) {
+            scalar_pixels[i] = static_cast<uint8_t>(std::clamp(wave.get_value(radii[i], time_sec), 0.0f, 255.0f));
+        }
+    });
+    const auto batch_ms = time_frames(iterations, [&](float time_sec) {
+        fill_ripple_batch(wave, time_sec, radii.data(), batch_pixels.data(), count);
+    });
+    const auto precomputed_ms = time_frames(iterations, [&](float time_sec) {
+        fill_ripple_batch(wave, time_sec, radii.data(), radial_damping.data(), batch_pixels.data(), count);
+    });
+    const auto profile_ms = time_frames(iterations, [&](float time_sec) {
+        profile.update(wave, time_sec);
+        profile.fill(radii.data(), profile_pixels.data(), count);
+    });
+
+    //!< accuracy over the same frames, in model units and in 8-bit output steps
+    double value_error = 0;
+    int batch_error = 0;
+    int profile_error = 0;
+    uint64_t batch_differing = 0;
+    uint64_t profile_differing = 0;
+    std::vector<float> values(count);
+    for ( uint64_t frame = 0; frame < iterations; frame++ ) {
+        const auto time_sec = static_cast<float>(frame) / 60.0f;
+        evaluate_ripple_batch(wave, time_sec, radii.data(), values.data(), count);
+        fill_ripple_batch(wave, time_sec, radii.data(), radial_damping.data(), batch_pixels.data(), count);
+        profile.update(wave, time_sec);
+        profile.fill(radii.data(), profile_pixels.data(), count);
+        for ( std::size_t i = 0; i < count; i++ ) {
+            const auto reference = wave.get_value(radii[i], time_sec);
+            value_error = std::max(value_error, static_cast<double>(std::fabs(values[i] - reference)));
+            scalar_pixels[i] = static_cast<uint8_t>(std::clamp(reference, 0.0f, 255.0f));
+        }
+        compare_pixels(scalar_pixels, batch_pixels, batch_error, batch_differing);
+        compare_pixels(scalar_pixels, profile_pixels, profile_error, profile_differing);
+    }
+
+    double exp_error = 0;
+    double sin_error = 0;
+    measure_approximations(exp_error, sin_error);
+
+    const auto speedup = [scalar_ms](double ms) { return (ms > 0.0) ? scalar_ms / ms : 0.0; };
+#if defined(FAST_MATH_SSE2)
+    const char* path = "sse2";
+#else
+    const char* path = "scalar polynomial";
+#endif
+    const auto total = count * iterations;
+    std::cout << "field: " << width << "x" << height << ", frames: " << iterations << ", batch path: " << path << "\n"
+              << "scalar: " << scalar_ms << " ms/frame\n"
+              << "batch: " << batch_ms << " ms/frame (" << speedup(batch_ms) << "x)\n"
+              << "precomputed geometry: " << precomputed_ms << " ms/frame (" << speedup(precomputed_ms) << "x)\n"
+              << "radial profile: " << profile_ms << " ms/frame (" << speedup(profile_ms) << "x), " << profile.bins()
+              << " bins for tolerance " << options.lut_tolerance << "\n"
+              << "batch max value error: " << value_error << ", max pixel error: " << batch_error << " (" << batch_differing
+              << " of " << total << " pixels differ)\n"
+              << "radial profile max pixel error: " << profile_error << " (" << profile_differing << " of " << total
+              << " pixels differ)\n"
+              << "fast_exp max relative error: " << exp_error << ", fast_sin max absolute error: " << sin_error << std::endl;
+    return 0;
+}
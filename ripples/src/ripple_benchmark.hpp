@@ -0,0 +1,25 @@
+/**
+ * \file ripple_benchmark.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief microbenchmark comparing the scalar ripple model against the batch evaluation for speed and accuracy
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ripple_options.hpp"
+
+/********************************** Functions *******************************************/
+/**
+ * \brief time the scalar, batch, precomputed geometry and radial profile paths over a field and report the speedups and the
+ *        maximum errors of the batch and radial profile output
+ *
+ * \param options field size, iteration count and lookup table tolerance
+ * \retval int process return value
+ */
+int run_ripple_benchmark(const ripple_options& options);
@@ -0,0 +1,45 @@
+/**
+ * \file ripple_engine.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief height field engine for the ripples sketch that is either the closed form ripple field or the wave equation solver
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_engine.hpp"
+#include "ripple_sources.hpp"
+#include <utility>
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief build the engine described by the command line options
+ *
+ * \param options the ripple options
+ * \retval std::optional<ripple_engine> the engine, or nothing if the ripple script could not be loaded
+ */
+std::optional<ripple_engine> make_ripple_engine(const ripple_options& options) {
+    const ripple wave{255, 1, 0.1};
+    std::optional<std::vector<ripple_event>> events;
+    if ( !options.script_path.empty() ) {
+        events = load_ripple_script(options.script_path, wave);
+        if ( !events ) {
+            return std::nullopt;
+        }
+    }
+
+    auto build = [&](auto&& field) {
+        if ( events ) {
+            field.schedule(std::move(*events));
+        }
+        field.set_rain(options.rain_per_sec);
+        return ripple_engine{std::move(field)};
+    };
+    if ( options.wave_equation ) {
+        return build(wave_field{options.field_size, options.field_size, wave, options.threads});
+    }
+    return build(ripple_field{options.field_size, options.field_size, wave, options.evaluation, options.lut_tolerance, options.threads});
+}
@@ -0,0 +1,90 @@
+/**
+ * \file ripple_engine.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief height field engine for the ripples sketch that is either the closed form ripple field or the wave equation solver
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ripple.hpp"
+#include "ripple_field.hpp"
+#include "ripple_options.hpp"
+#include "wave_field.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/********************************** Types *******************************************/
+/**
+ * \brief the engine chosen at startup. Forwards the height field engine interface to whichever field it holds so that
+ *        the view, the headless runner and the application only deal with one type.
+ */
+class ripple_engine {
+  public:
+    /**
+     * \brief Construct a new ripple engine object
+     *
+     * \param field a ripple_field or wave_field
+     */
+    template <typename Field, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Field>, ripple_engine>>>
+    explicit ripple_engine(Field&& field)
+        : _field(std::forward<Field>(field)) { }
+
+    bool update(double time_sec) {
+        return std::visit([time_sec](auto& field) { return field.update(time_sec); }, _field);
+    }
+
+    void fill(uint8_t* pixels) const {
+        std::visit([pixels](const auto& field) { field.fill(pixels); }, _field);
+    }
+
+    void resize(std::size_t width, std::size_t height) {
+        std::visit([width, height](auto& field) { field.resize(width, height); }, _field);
+    }
+
+    void spawn(float x, float y, const ripple& wave) {
+        std::visit([x, y, &wave](auto& field) { field.spawn(x, y, wave); }, _field);
+    }
+
+    /**
+     * \brief place an obstacle. Only the wave equation solver has obstacles, the closed form field ignores this.
+     *
+     * \param x column of the center in field pixels
+     * \param y row of the center in field pixels
+     * \param radius radius in field pixels
+     */
+    void add_obstacle(float x, float y, float radius) {
+        if ( auto* field = std::get_if<wave_field>(&_field) ) {
+            field->add_obstacle(x, y, radius);
+        }
+    }
+
+    std::size_t width() const {
+        return std::visit([](const auto& field) { return field.width(); }, _field);
+    }
+
+    std::size_t height() const {
+        return std::visit([](const auto& field) { return field.height(); }, _field);
+    }
+
+  private:
+    std::variant<ripple_field, wave_field> _field;
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief build the engine described by the command line options
+ *
+ * \param options the ripple options
+ * \retval std::optional<ripple_engine> the engine, or nothing if the ripple script could not be loaded
+ */
+std::optional<ripple_engine> make_ripple_engine(const ripple_options& options);
@@ -0,0 +1,221 @@
+/**
+ * \file ripple_field.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief evaluates a ripple over a 2D grid to create an 8-bit height field
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_field.hpp"
+#include "ripple_batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief generic function to turn calculate the radius of a cartesian point
+ *
+ * \tparam T type of the points x and y
+ * \param x coordinate
+ * \param y coordinate
+ * \retval return type deduced based on arguments
+ */
+template <typename T>
+auto calculate_radius(T&& x, T&& y) {
+    return std::sqrt(std::pow(x, 2.0) + std::pow(y, 2.0));
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new ripple field object
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param wave the ripple model to evaluate
+ * \param evaluation evaluate every pixel or interpolate a radial profile
+ * \param lut_tolerance maximum interpolation error of the radial profile in 8-bit steps
+ * \param threads threads used to fill the field. Zero uses the hardware concurrency.
+ */
+ripple_field::ripple_field(std::size_t width,
+                           std::size_t height,
+                           const ripple& wave,
+                           ripple_evaluation evaluation,
+                           float lut_tolerance,
+                           unsigned threads)
+    : _width(width)
+    , _height(height)
+    , _extent_width(width)
+    , _extent_height(height)
+    , _spacing(1.0f)
+    , _settled(false)
+    , _x_origin(static_cast<int>(width / 2))
+    , _y_origin(static_cast<int>(height / 2))
+    , _wave(wave)
+    , _time_sec(0)
+    , _evaluation(evaluation)
+    , _lut_tolerance(lut_tolerance)
+    , _pool(std::make_unique<worker_pool>(threads))
+    , _sources(width, height)
+    , _spawner(wave) {
+    build_geometry();
+}
+
+/**
+ * \brief advance the field to a new point in time
+ *
+ * \param time_sec simulation time in seconds
+ * \retval true if the output changed
+ */
+bool ripple_field::update(double time_sec) {
+    const auto previous_sec = _time_sec;
+    _time_sec = static_cast<float>(time_sec);
+
+    _due.clear();
+    _spawner.collect(previous_sec, _time_sec, _extent_width, _extent_height, _due);
+    for ( const auto& event : _due ) {
+        _sources.spawn(event);
+    }
+    _sources.update(_time_sec);
+
+    //!< every value is at most impulse * exp(-damping * t), so once that truncates to zero and no spawned ripples are left
+    //!< the whole field is zero. Report one last change so the flat field is shown, then nothing until a disturbance.
+    const auto peak = _wave.impulse * std::exp(-_wave.damping * _time_sec);
+    const bool settled = (_wave.damping > 0.0f) && (peak < 1.0f) && (_sources.active() == 0);
+    const bool changed = !(settled && _settled);
+    _settled = settled;
+    if ( changed && _profile ) {
+        _profile->update(_wave, _time_sec);
+    }
+    return changed;
+}
+
+/**
+ * \brief write the field into a row major 8-bit buffer of width * height pixels. Each band of rows is evaluated as one
+ *        batch and then has the spawned ripples added while it is still in cache.
+ *
+ * \param pixels the output buffer
+ */
+void ripple_field::fill(uint8_t* pixels) const {
+    _pool->for_each_band(_height, [this, pixels](std::size_t first, std::size_t last) { fill_rows(pixels, first, last); });
+}
+
+/**
+ * \brief change the resolution of the field and rebuild the per-pixel geometry
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ */
+void ripple_field::resize(std::size_t width, std::size_t height) {
+    _width = width;
+    _height = height;
+    _spacing = static_cast<float>(_extent_width) / static_cast<float>(std::max<std::size_t>(width, 1));
+    _x_origin = static_cast<int>(width / 2);
+    _y_origin = static_cast<int>(height / 2);
+    build_geometry();
+    _sources.resize(width, height, _spacing);
+    _sources.update(_time_sec);
+    _settled = false;
+}
+
+/**
+ * \brief spawn a ripple at the current simulation time
+ *
+ * \param x column in field pixels
+ * \param y row in field pixels
+ * \param wave the ripple model
+ */
+void ripple_field::spawn(float x, float y, const ripple& wave) {
+    _sources.spawn(ripple_event{_time_sec, x * _spacing, y * _spacing, wave});
+}
+
+/**
+ * \brief schedule ripples to spawn once the simulation reaches their time
+ *
+ * \param events ripples sorted by time
+ */
+void ripple_field::schedule(std::vector<ripple_event>&& events) {
+    _spawner.schedule(std::move(events));
+}
+
+/**
+ * \brief spawn ripples at random positions at a steady rate
+ *
+ * \param per_sec ripples per simulated second
+ */
+void ripple_field::set_rain(float per_sec) {
+    _spawner.set_rain(per_sec);
+}
+
+/**
+ * \brief get the number of spawned ripples that have not expired
+ *
+ * \retval std::size_t
+ */
+std::size_t ripple_field::active_sources() const {
+    return _sources.active();
+}
+
+/**
+ * \brief get the width of the field
+ *
+ * \retval std::size_t width in pixels
+ */
+std::size_t ripple_field::width() const {
+    return _width;
+}
+
+/**
+ * \brief get the height of the field
+ *
+ * \retval std::size_t height in pixels
+ */
+std::size_t ripple_field::height() const {
+    return _height;
+}
+
+/**
+ * \brief compute the radius (in extent units) and radial damping of every pixel, and size the radial profile for the largest radius
+ */
+void ripple_field::build_geometry() {
+    _radii.resize(_width * _height);
+    _radial_damping.resize(_width * _height);
+    for ( std::size_t row = 0; row < _height; row++ ) {
+        for ( std::size_t column = 0; column < _width; column++ ) {
+            uint64_t x = std::llabs(static_cast<long long>(column) - _x_origin);
+            uint64_t y = std::llabs(static_cast<long long>(row) - _y_origin);
+            const auto index = row * _width + column;
+            _radii[index] = static_cast<float>(calculate_radius(x, y)) * _spacing;
+            _radial_damping[index] = std::exp(-_wave.damping * _radii[index]);
+        }
+    }
+
+    if ( _evaluation == ripple_evaluation::radial_profile ) {
+        const auto max_radius = _radii.empty() ? 0.0f : *std::max_element(_radii.begin(), _radii.end());
+        _profile.emplace(_wave, max_radius, _lut_tolerance);
+        _profile->update(_wave, _time_sec);
+    }
+}
+
+/**
+ * \brief write a band of rows of the field
+ *
+ * \param pixels the whole output buffer
+ * \param first_row first row of the band
+ * \param last_row one past the last row of the band
+ */
+void ripple_field::fill_rows(uint8_t* pixels, std::size_t first_row, std::size_t last_row) const {
+    const auto offset = first_row * _width;
+    const auto count = (last_row - first_row) * _width;
+    if ( _profile ) {
+        _profile->fill(_radii.data() + offset, pixels + offset, count);
+    } else {
+        fill_ripple_batch(_wave, _time_sec, _radii.data() + offset, _radial_damping.data() + offset, pixels + offset, count);
+    }
+    _sources.accumulate(pixels, first_row, last_row);
+}
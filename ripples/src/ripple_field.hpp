@@ -0,0 +1,131 @@
+/**
+ * \file ripple_field.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief evaluates a ripple over a 2D grid to create an 8-bit height field
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "radial_profile.hpp"
+#include "ripple.hpp"
+#include "ripple_options.hpp"
+#include "ripple_sources.hpp"
+#include "worker_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief height field engine for a single ripple centered on the grid. This has no dependencies on open frameworks
+ *        so that it can run headless. The radius and radial damping of every pixel never change, so they are computed
+ *        once when the field is built or resized and each frame only does the time dependent work. In radial profile mode the
+ *        model is only evaluated at radial bins and each pixel interpolates between them. Ripples spawned by clicks, a script
+ *        or rain are added on top of the centered ripple. The fill is split into row bands on a worker pool; every pixel
+ *        only depends on the time passed to update, so the output is the same for any number of threads.
+ */
+class ripple_field {
+  public:
+    /**
+     * \brief Construct a new ripple field object
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param wave the ripple model to evaluate
+     * \param evaluation evaluate every pixel or interpolate a radial profile
+     * \param lut_tolerance maximum interpolation error of the radial profile in 8-bit steps
+     * \param threads threads used to fill the field. Zero uses the hardware concurrency.
+     */
+    ripple_field(std::size_t width,
+                 std::size_t height,
+                 const ripple& wave,
+                 ripple_evaluation evaluation = ripple_evaluation::batch,
+                 float lut_tolerance = 0.5f,
+                 unsigned threads = 0);
+
+    /**
+     * \brief advance the field to a new point in time
+     *
+     * \param time_sec simulation time in seconds
+     * \retval true if the output changed. False once the ripple has decayed below one 8-bit step and no spawned ripples
+     *         are left, until the next disturbance.
+     */
+    bool update(double time_sec);
+
+    /**
+     * \brief write the field into a row major 8-bit buffer of width * height pixels
+     *
+     * \param pixels the output buffer
+     */
+    void fill(uint8_t* pixels) const;
+
+    /**
+     * \brief change the resolution of the field and rebuild the per-pixel geometry. The field keeps the extent it was built
+     *        with, so ripples keep their size and position on screen and only the spacing between pixels changes.
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     */
+    void resize(std::size_t width, std::size_t height);
+
+    /**
+     * \brief spawn a ripple at the current simulation time
+     *
+     * \param x column in field pixels
+     * \param y row in field pixels
+     * \param wave the ripple model
+     */
+    void spawn(float x, float y, const ripple& wave);
+
+    /**
+     * \brief schedule ripples to spawn once the simulation reaches their time
+     *
+     * \param events ripples sorted by time
+     */
+    void schedule(std::vector<ripple_event>&& events);
+
+    /**
+     * \brief spawn ripples at random positions at a steady rate. The generator is seeded so that runs are repeatable.
+     *
+     * \param per_sec ripples per simulated second
+     */
+    void set_rain(float per_sec);
+
+    std::size_t active_sources() const;
+    std::size_t width() const;
+    std::size_t height() const;
+
+  private:
+    void build_geometry();
+    void fill_rows(uint8_t* pixels, std::size_t first_row, std::size_t last_row) const;
+
+    std::size_t _width;
+    std::size_t _height;
+    std::size_t _extent_width;   //!< size the field was built with. Ripple positions and radii are in these units.
+    std::size_t _extent_height;
+    float _spacing;              //!< extent units per pixel
+    bool _settled;               //!< the last update found the field flat
+    int _x_origin;
+    int _y_origin;
+    ripple _wave;
+    float _time_sec;
+    std::vector<float> _radii;           //!< distance of each pixel from the origin
+    std::vector<float> _radial_damping;  //!< exp(-damping * radius) of each pixel
+    ripple_evaluation _evaluation;
+    float _lut_tolerance;
+    std::optional<radial_profile> _profile;
+    std::unique_ptr<worker_pool> _pool;
+
+    //!< spawned ripples
+    ripple_sources _sources;
+    ripple_spawner _spawner;
+    std::vector<ripple_event> _due;  //!< scratch list of ripples spawning this frame
+};
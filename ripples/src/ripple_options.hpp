@@ -0,0 +1,97 @@
+/**
+ * \file ripple_options.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief command line options specific to the ripples sketch. These layer on top of the shared sketch_options.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+/********************************** Types *******************************************/
+/**
+ * \brief how the ripple field is evaluated each frame
+ */
+enum class ripple_evaluation : unsigned {
+    batch = 0,       //!< evaluate the model at every pixel
+    radial_profile,  //!< evaluate the model at radial bins and interpolate per pixel
+};
+
+/**
+ * \brief options for the ripples sketch
+ */
+struct ripple_options {
+    std::size_t field_size = 160;                            //!< width and height of the field in pixels
+    ripple_evaluation evaluation = ripple_evaluation::batch;
+    float lut_tolerance = 0.5f;                              //!< maximum interpolation error of the radial profile in 8-bit steps
+    std::string script_path;                                 //!< file of scripted ripples to spawn
+    float rain_per_sec = 0.0f;                               //!< random ripples spawned per simulated second
+    bool wave_equation = false;                              //!< integrate the wave equation instead of the closed form ripple
+    unsigned threads = 0;                                    //!< threads that fill or step the field, zero for the hardware concurrency
+    bool shader = false;                                     //!< evaluate the centered ripple in the vertex shader instead of on the CPU
+    bool verify_shader = false;                              //!< compare the shader and CPU pipelines and exit
+    bool benchmark = false;                                  //!< run the evaluation benchmark and exit
+    uint64_t iterations = 50;                                //!< frames to time for each path in the benchmark or shader verification
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief parse the ripple options from the command line. Unknown arguments are ignored since the shared sketch options are
+ *        parsed from the same arguments.
+ *
+ *        --size <n>              width and height of the field in pixels
+ *        --lut                   evaluate through a per-frame radial profile lookup table
+ *        --lut-tolerance <v>     maximum interpolation error of the lookup table in 8-bit steps
+ *        --script <file>         spawn ripples from a script of "time_sec x y [impulse propagation damping]" lines
+ *        --rain <n>              spawn n ripples per second at random positions
+ *        --wave                  integrate the wave equation instead of the closed form ripple
+ *        --threads <n>           threads that fill or step the field
+ *        --shader                evaluate the centered ripple in the vertex shader, no CPU fill or texture upload
+ *        --verify-shader         compare the shader model against the CPU field, time both pipelines and exit
+ *        --benchmark             compare the evaluation paths and exit
+ *        --iterations <n>        frames to time for each path in the benchmark or shader verification
+ *
+ * \param argc number of CLI arguments
+ * \param argv list of arguments
+ * \retval ripple_options
+ */
+inline ripple_options parse_ripple_options(int argc, char* argv[]) {
+    ripple_options options;
+    for ( int i = 1; i < argc; i++ ) {
+        const std::string argument{argv[i]};
+        const bool has_value = (i + 1) < argc;
+        if ( argument == "--size" && has_value ) {
+            options.field_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if ( argument == "--lut" ) {
+            options.evaluation = ripple_evaluation::radial_profile;
+        } else if ( argument == "--lut-tolerance" && has_value ) {
+            options.lut_tolerance = std::strtof(argv[++i], nullptr);
+        } else if ( argument == "--script" && has_value ) {
+            options.script_path = argv[++i];
+        } else if ( argument == "--rain" && has_value ) {
+            options.rain_per_sec = std::strtof(argv[++i], nullptr);
+        } else if ( argument == "--wave" ) {
+            options.wave_equation = true;
+        } else if ( argument == "--threads" && has_value ) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if ( argument == "--shader" ) {
+            options.shader = true;
+        } else if ( argument == "--verify-shader" ) {
+            options.verify_shader = true;
+        } else if ( argument == "--benchmark" ) {
+            options.benchmark = true;
+        } else if ( argument == "--iterations" && has_value ) {
+            options.iterations = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+    return options;
+}
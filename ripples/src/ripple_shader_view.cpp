@@ -0,0 +1,240 @@
+/**
+ * \file ripple_shader_view.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief renders the centered ripple by evaluating the model in the displacement vertex shader
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_shader_view.hpp"
+#include "ripple_field.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+/********************************** Constants *******************************************/
+constexpr float verify_scale = 200.0f;  //!< displacement scale used when timing the pipelines, same as the sketch
+
+/********************************** Local Function Definitions *******************************************/
+/**
+ * \brief get the path of a shader in the sketch shaders directory
+ *
+ * \param name shader path relative to the shaders directory, without an extension
+ * \retval std::filesystem::path
+ */
+static std::filesystem::path shader_path(const std::string& name) {
+    return std::filesystem::current_path().parent_path() / std::filesystem::path{"shaders"} / std::filesystem::path{name};
+}
+
+/**
+ * \brief set the ripple model uniforms declared in ripple.glsl
+ *
+ * \param shader a shader that includes ripple.glsl
+ * \param wave the ripple model
+ * \param time_sec time since the impulse
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ */
+static void set_ripple_uniforms(const ofShader& shader, const ripple& wave, float time_sec, std::size_t width, std::size_t height) {
+    //!< the CPU field puts the origin on the integer pixel (width / 2, height / 2)
+    shader.setUniform1f("u_time", time_sec);
+    shader.setUniform2f("u_origin", static_cast<float>(width / 2), static_cast<float>(height / 2));
+    shader.setUniform1f("u_impulse", wave.impulse);
+    shader.setUniform1f("u_propagation", wave.propagation);
+    shader.setUniform1f("u_damping", wave.damping);
+}
+
+/**
+ * \brief move the plane into the center of the screen and tilt it the same way heightfield_view does
+ */
+static void apply_plane_transform() {
+    ofTranslate(ofGetWidth() / 2.0, ofGetHeight() / 2.0);
+    auto rotation = ofMap(0.30, 0, 1, -60, 60, true) + 60;
+    ofRotateDeg(rotation, 1, 0, 0);
+}
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new ripple shader view object
+ *
+ * \param wave the ripple model
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param settings render settings
+ * \param options sketch options
+ */
+ripple_shader_view::ripple_shader_view(const ripple& wave,
+                                       std::size_t width,
+                                       std::size_t height,
+                                       const heightfield_settings& settings,
+                                       const sketch_options& options)
+    : _wave(wave)
+    , _width(width)
+    , _height(height)
+    , _settings(settings)
+    , _profiler({"draw_wireframe"}, options.profile)
+    , _time_sec(0) {
+    _plane.set(_settings.plane_width,
+               _settings.plane_height,
+               (_settings.mesh_columns > 0) ? _settings.mesh_columns : static_cast<int>(width),
+               (_settings.mesh_rows > 0) ? _settings.mesh_rows : static_cast<int>(height),
+               OF_PRIMITIVE_TRIANGLES);
+    //!< the same texel coordinates the texture path maps from a width x height rectangle texture
+    _plane.mapTexCoords(0, 0, static_cast<float>(width), static_cast<float>(height));
+}
+
+/**
+ * \brief load the ripple shader from the sketch shaders directory
+ */
+void ripple_shader_view::setup() {
+    _shader.load(shader_path("shadersGL3/ripple"));
+}
+
+/**
+ * \brief set the time of the next frame
+ *
+ * \param time_sec simulation time
+ */
+void ripple_shader_view::update(double time_sec) {
+    _time_sec = static_cast<float>(time_sec);
+}
+
+/**
+ * \brief render the ripple as a displaced wireframe
+ *
+ * \param scale displacement scale passed to the shader
+ */
+void ripple_shader_view::draw(float scale) {
+    _shader.begin();
+    _shader.setUniform1f(_settings.scale_uniform, scale);
+    set_ripple_uniforms(_shader, _wave, _time_sec, _width, _height);
+
+    ofPushMatrix();
+    apply_plane_transform();
+    {
+        frame_profiler::scope timer{_profiler, stage_draw_wireframe};
+        _plane.drawWireframe();
+    }
+    ofPopMatrix();
+    _shader.end();
+
+    if ( _profiler.enabled() ) {
+        draw_profiler_overlay(_profiler);
+    }
+}
+
+/**
+ * \brief get the frame profiler
+ *
+ * \retval frame_profiler&
+ */
+frame_profiler& ripple_shader_view::profiler() {
+    return _profiler;
+}
+
+/**
+ * \brief compare the shader model against the CPU ripple_field and time both pipelines
+ *
+ * \param options ripple options for the field size and the number of frames to time
+ * \retval int zero if every pixel is within one 8-bit step of the CPU output
+ */
+int verify_ripple_shader(const ripple_options& options) {
+    const ripple wave{255, 1, 0.1};
+    const auto size = options.field_size;
+    ripple_field field{size, size, wave, options.evaluation, options.lut_tolerance, options.threads};
+
+    ofShader verify_shader;
+    ofShader ripple_shader;
+    ofShader texture_shader;
+    if ( !verify_shader.load(shader_path("shadersGL3/ripple_verify")) || !ripple_shader.load(shader_path("shadersGL3/ripple")) ||
+         !texture_shader.load(shader_path("shadersGL3/shader")) ) {
+        ofLogError("ripples") << "could not load the ripple shaders";
+        return 1;
+    }
+
+    //!< render the model one fragment per field pixel into a float target and compare it with the CPU fill
+    ofFbo target;
+    target.allocate(static_cast<int>(size), static_cast<int>(size), GL_RGBA32F);
+    std::vector<float> values(size * size);
+    std::vector<uint8_t> pixels(size * size);
+    int max_error = 0;
+    std::size_t differ = 0;
+    for ( const auto time_sec : {0.0f, 0.5f, 1.0f, 3.0f, 10.0f, 30.0f} ) {
+        field.update(time_sec);
+        field.fill(pixels.data());
+
+        target.begin();
+        verify_shader.begin();
+        set_ripple_uniforms(verify_shader, wave, time_sec, size, size);
+        ofDrawRectangle(0, 0, static_cast<float>(size), static_cast<float>(size));
+        verify_shader.end();
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, static_cast<int>(size), static_cast<int>(size), GL_RED, GL_FLOAT, values.data());
+        target.end();
+
+        for ( std::size_t i = 0; i < pixels.size(); i++ ) {
+            const auto error = std::abs(static_cast<int>(std::lround(values[i] * 255.0f)) - static_cast<int>(pixels[i]));
+            max_error = std::max(max_error, error);
+            differ += (error > 0) ? 1 : 0;
+        }
+    }
+    ofLogNotice("ripples") << "shader vs cpu: max error " << max_error << " steps, " << differ << " of " << 6 * pixels.size()
+                           << " pixels differ";
+
+    //!< time each pipeline drawing the wireframe into a window sized buffer, waiting for the GPU every frame
+    ofFbo screen;
+    screen.allocate(std::max(ofGetWidth(), 1), std::max(ofGetHeight(), 1), GL_RGBA);
+    ofPlanePrimitive plane;
+    plane.set(1200, 900, static_cast<int>(size), static_cast<int>(size), OF_PRIMITIVE_TRIANGLES);
+    plane.mapTexCoords(0, 0, static_cast<float>(size), static_cast<float>(size));
+    ofPixels frame;
+    frame.allocate(size, size, OF_PIXELS_GRAY);
+    ofTexture texture;
+    texture.allocate(frame);
+
+    auto time_pipeline = [&](const std::function<void(float)>& draw_frame) {
+        const auto start = std::chrono::steady_clock::now();
+        for ( uint64_t i = 0; i < options.iterations; i++ ) {
+            screen.begin();
+            ofClear(0, 0, 0, 255);
+            ofPushMatrix();
+            apply_plane_transform();
+            draw_frame(static_cast<float>(i) / 60.0f);
+            ofPopMatrix();
+            screen.end();
+            glFinish();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(std::max<uint64_t>(options.iterations, 1));
+    };
+
+    const auto cpu_ms = time_pipeline([&](float time_sec) {
+        field.update(time_sec);
+        field.fill(frame.getData());
+        texture.loadData(frame);
+        texture.bind();
+        texture_shader.begin();
+        texture_shader.setUniform1f("u_scale", verify_scale);
+        plane.drawWireframe();
+        texture_shader.end();
+        texture.unbind();
+    });
+    const auto shader_ms = time_pipeline([&](float time_sec) {
+        ripple_shader.begin();
+        ripple_shader.setUniform1f("u_scale", verify_scale);
+        set_ripple_uniforms(ripple_shader, wave, time_sec, size, size);
+        plane.drawWireframe();
+        ripple_shader.end();
+    });
+    ofLogNotice("ripples") << "field " << size << "x" << size << ", " << options.iterations << " frames: cpu fill + upload "
+                           << cpu_ms << " ms/frame, vertex shader " << shader_ms << " ms/frame";
+    return (max_error <= 1) ? 0 : 1;
+}
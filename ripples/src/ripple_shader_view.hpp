@@ -0,0 +1,92 @@
+/**
+ * \file ripple_shader_view.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief renders the centered ripple by evaluating the model in the displacement vertex shader
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ofMain.h"
+#include "frame_profiler.hpp"
+#include "heightfield_view.hpp"
+#include "ripple.hpp"
+#include "ripple_options.hpp"
+#include "sketch_options.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/********************************** Types *******************************************/
+/**
+ * \brief alternative to heightfield_view for the ripples sketch. The ripple is evaluated per vertex in
+ *        shadersGL3/ripple.vert from uniforms, so there is no CPU fill and no texture upload. The model is shared with the
+ *        verification pass through shadersGL3/ripple.glsl and matches ripple_field pixel for pixel. Only the centered
+ *        ripple is drawn: spawned ripples, the wave equation solver and recording need the CPU path.
+ */
+class ripple_shader_view {
+  public:
+    //!< stages timed by the frame profiler
+    enum profile_stage : uint32_t { stage_draw_wireframe = 0 };
+
+    /**
+     * \brief Construct a new ripple shader view object. Must be created after the GL context.
+     *
+     * \param wave the ripple model
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param settings render settings
+     * \param options sketch options
+     */
+    ripple_shader_view(const ripple& wave,
+                       std::size_t width,
+                       std::size_t height,
+                       const heightfield_settings& settings,
+                       const sketch_options& options);
+
+    /**
+     * \brief load the ripple shader from the sketch shaders directory
+     */
+    void setup();
+
+    /**
+     * \brief set the time of the next frame
+     *
+     * \param time_sec simulation time
+     */
+    void update(double time_sec);
+
+    /**
+     * \brief render the ripple as a displaced wireframe
+     *
+     * \param scale displacement scale passed to the shader
+     */
+    void draw(float scale);
+
+    frame_profiler& profiler();
+
+  private:
+    ripple _wave;
+    std::size_t _width;
+    std::size_t _height;
+    heightfield_settings _settings;
+    frame_profiler _profiler;
+    ofShader _shader;
+    ofPlanePrimitive _plane;
+    float _time_sec;
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief compare the shader model against the CPU ripple_field and time both pipelines. The shader model is rendered into
+ *        a float frame buffer one fragment per field pixel and read back, then each pipeline draws the wireframe into an
+ *        offscreen buffer the size of the window with the GPU finished every frame. Must be called with a GL context.
+ *
+ * \param options ripple options for the field size and the number of frames to time
+ * \retval int zero if every pixel is within one 8-bit step of the CPU output
+ */
+int verify_ripple_shader(const ripple_options& options);
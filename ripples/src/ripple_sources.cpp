@@ -0,0 +1,325 @@
+/**
+ * \file ripple_sources.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief superposition of many short lived ripples spawned at arbitrary points
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "ripple_sources.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new ripple sources object
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param threshold contribution below which a ripple is ignored, in 8-bit steps
+ * \param tile_size width and height of a culling tile in pixels
+ */
+ripple_sources::ripple_sources(std::size_t width, std::size_t height, float threshold, std::size_t tile_size)
+    : _spacing(1.0f)
+    , _threshold(threshold)
+    , _tile_size(std::max<std::size_t>(tile_size, 4)) {
+    resize(width, height);
+}
+
+/**
+ * \brief add a ripple
+ *
+ * \param event the ripple and where and when it starts
+ */
+void ripple_sources::spawn(const ripple_event& event) {
+    _events.push_back(event);
+}
+
+/**
+ * \brief remove expired ripples, compute the per-frame terms and cutoff radius of the rest and bin them into tiles
+ *
+ * \param time_sec simulation time
+ */
+void ripple_sources::update(float time_sec) {
+    //!< a ripple has expired once its peak, impulse * exp(-damping * t), can no longer reach the threshold
+    _events.erase(std::remove_if(_events.begin(),
+                                 _events.end(),
+                                 [this, time_sec](const ripple_event& event) {
+                                     const auto age = time_sec - event.time_sec;
+                                     return (event.wave.damping > 0.0f) && (age > 0.0f) &&
+                                            (event.wave.impulse * std::exp(-event.wave.damping * age) < _threshold);
+                                 }),
+                  _events.end());
+
+    const auto diagonal_squared = static_cast<float>(_width * _width + _height * _height);
+    _sources.clear();
+    for ( auto& bin : _tile_bins ) {
+        bin.clear();
+    }
+
+    for ( const auto& event : _events ) {
+        const auto age = time_sec - event.time_sec;
+        if ( age < 0.0f ) {
+            continue;
+        }
+
+        //!< scale the terms so that they take radii in pixels rather than field units
+        ripple_terms terms{event.wave, age};
+        terms.frequency *= _spacing;
+        terms.radial_rate *= _spacing;
+        const auto x = event.x / _spacing;
+        const auto y = event.y / _spacing;
+
+        //!< amplitude * exp(-damping * r) < threshold past r = ln(amplitude / threshold) / damping
+        auto cutoff_squared = diagonal_squared;
+        if ( event.wave.damping > 0.0f ) {
+            const auto cutoff = std::log(std::max(terms.amplitude, _threshold) / _threshold) / -terms.radial_rate;
+            cutoff_squared = std::min(cutoff * cutoff, diagonal_squared);
+        }
+        const auto cutoff = std::sqrt(cutoff_squared);
+        if ( (cutoff <= 0.0f) || (x + cutoff < 0.0f) || (y + cutoff < 0.0f) || (x - cutoff >= _width) || (y - cutoff >= _height) ) {
+            continue;
+        }
+
+        //!< bin into every tile the bounding box touches, then drop the corner tiles the circle misses
+        const auto index = static_cast<uint32_t>(_sources.size());
+        _sources.push_back(source{x, y, cutoff_squared, terms});
+        const auto first_x = static_cast<std::size_t>(std::max(0.0f, x - cutoff)) / _tile_size;
+        const auto first_y = static_cast<std::size_t>(std::max(0.0f, y - cutoff)) / _tile_size;
+        const auto last_x = std::min(static_cast<std::size_t>(x + cutoff) / _tile_size, _tiles_x - 1);
+        const auto last_y = std::min(static_cast<std::size_t>(y + cutoff) / _tile_size, _tiles_y - 1);
+        for ( auto tile_y = first_y; tile_y <= last_y; tile_y++ ) {
+            for ( auto tile_x = first_x; tile_x <= last_x; tile_x++ ) {
+                const auto left = static_cast<float>(tile_x * _tile_size);
+                const auto top = static_cast<float>(tile_y * _tile_size);
+                const auto nearest_x = std::clamp(x, left, left + _tile_size - 1);
+                const auto nearest_y = std::clamp(y, top, top + _tile_size - 1);
+                const auto dx = nearest_x - x;
+                const auto dy = nearest_y - y;
+                if ( dx * dx + dy * dy < cutoff_squared ) {
+                    _tile_bins[tile_y * _tiles_x + tile_x].push_back(index);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief add the active ripples onto a row major 8-bit field, clamping to [0, 255]
+ *
+ * \param pixels the field
+ */
+void ripple_sources::accumulate(uint8_t* pixels) const {
+    accumulate(pixels, 0, _height);
+}
+
+/**
+ * \brief add the active ripples onto a band of rows of a row major 8-bit field
+ *
+ * \param pixels the whole field
+ * \param first_row first row of the band
+ * \param last_row one past the last row of the band
+ */
+void ripple_sources::accumulate(uint8_t* pixels, std::size_t first_row, std::size_t last_row) const {
+    last_row = std::min(last_row, _height);
+    if ( first_row >= last_row ) {
+        return;
+    }
+
+    //!< padded so that a span can always finish its last group of four lanes past the tile edge
+    std::vector<float> sums(_tile_size + 3);
+    const auto first_tile_y = first_row / _tile_size;
+    const auto last_tile_y = std::min((last_row - 1) / _tile_size + 1, _tiles_y);
+    for ( auto tile_y = first_tile_y; tile_y < last_tile_y; tile_y++ ) {
+        const auto top = std::max(tile_y * _tile_size, first_row);
+        const auto bottom = std::min((tile_y + 1) * _tile_size, last_row);
+        for ( std::size_t tile_x = 0; tile_x < _tiles_x; tile_x++ ) {
+            if ( !_tile_bins[tile_y * _tiles_x + tile_x].empty() ) {
+                accumulate_tile(tile_x, tile_y, top, bottom, sums.data(), pixels);
+            }
+        }
+    }
+}
+
+/**
+ * \brief sum the ripples binned into one tile. Each ripple only visits the span of each row that lies within its cutoff.
+ *
+ * \param tile_x tile column
+ * \param tile_y tile row
+ * \param top first row of the tile to sum
+ * \param bottom one past the last row of the tile to sum
+ * \param sums scratch row of at least tile size + 3 floats
+ * \param pixels the field
+ */
+void ripple_sources::accumulate_tile(std::size_t tile_x, std::size_t tile_y, std::size_t top, std::size_t bottom, float* sums, uint8_t* pixels) const {
+    const auto& bin = _tile_bins[tile_y * _tiles_x + tile_x];
+    const auto left = tile_x * _tile_size;
+    const auto right = std::min(left + _tile_size, _width);
+    const auto columns = right - left;
+
+    for ( auto row = top; row < bottom; row++ ) {
+        std::fill(sums, sums + columns, 0.0f);
+        for ( const auto index : bin ) {
+            const auto& source = _sources[index];
+            const auto dy = static_cast<float>(row) - source.y;
+            const auto span_squared = source.cutoff_squared - dy * dy;
+            if ( span_squared <= 0.0f ) {
+                continue;
+            }
+            const auto span = std::sqrt(span_squared);
+            const auto first = static_cast<std::size_t>(std::clamp(std::ceil(source.x - span), static_cast<float>(left), static_cast<float>(right)));
+            const auto last = static_cast<std::size_t>(std::clamp(std::floor(source.x + span) + 1.0f, static_cast<float>(left), static_cast<float>(right)));
+
+            auto column = first;
+#if defined(FAST_MATH_SSE2)
+            const auto dy_squared = _mm_set1_ps(dy * dy);
+            const auto lane_offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            for ( ; column < last; column += 4 ) {
+                const auto dx = _mm_add_ps(_mm_set1_ps(static_cast<float>(column) - source.x), lane_offsets);
+                const auto radius = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dy_squared));
+                float* sum = sums + (column - left);
+                _mm_storeu_ps(sum, _mm_add_ps(_mm_loadu_ps(sum), source.terms.evaluate(radius)));
+            }
+#endif
+            for ( ; column < last; column++ ) {
+                const auto dx = static_cast<float>(column) - source.x;
+                sums[column - left] += source.terms.evaluate(std::sqrt(dx * dx + dy * dy));
+            }
+        }
+
+        auto* output = pixels + row * _width + left;
+        for ( std::size_t i = 0; i < columns; i++ ) {
+            output[i] = to_pixel(static_cast<float>(output[i]) + sums[i]);
+        }
+    }
+}
+
+/**
+ * \brief change the field size
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param spacing units of the ripple positions and radii per pixel
+ */
+void ripple_sources::resize(std::size_t width, std::size_t height, float spacing) {
+    _spacing = spacing;
+    _width = width;
+    _height = height;
+    _tiles_x = std::max<std::size_t>((width + _tile_size - 1) / _tile_size, 1);
+    _tiles_y = std::max<std::size_t>((height + _tile_size - 1) / _tile_size, 1);
+    _tile_bins.assign(_tiles_x * _tiles_y, {});
+    _sources.clear();
+}
+
+/**
+ * \brief get the number of ripples that have not expired
+ *
+ * \retval std::size_t
+ */
+std::size_t ripple_sources::active() const {
+    return _events.size();
+}
+
+/**
+ * \brief Construct a new ripple spawner object
+ *
+ * \param wave ripple parameters for rain drops
+ */
+ripple_spawner::ripple_spawner(const ripple& wave)
+    : _wave(wave)
+    , _next_scheduled(0)
+    , _rain_per_sec(0)
+    , _rain_due(0)
+    , _rain_generator(1) { }
+
+/**
+ * \brief schedule ripples to spawn once the simulation reaches their time
+ *
+ * \param events ripples sorted by time
+ */
+void ripple_spawner::schedule(std::vector<ripple_event>&& events) {
+    _scheduled = std::move(events);
+    _next_scheduled = 0;
+}
+
+/**
+ * \brief spawn ripples at random positions at a steady rate
+ *
+ * \param per_sec ripples per simulated second
+ */
+void ripple_spawner::set_rain(float per_sec) {
+    _rain_per_sec = per_sec;
+}
+
+/**
+ * \brief append the ripples due between two points in time
+ *
+ * \param previous_sec time of the previous update
+ * \param time_sec current simulation time
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param due the ripples that should spawn now
+ */
+void ripple_spawner::collect(float previous_sec, float time_sec, std::size_t width, std::size_t height, std::vector<ripple_event>& due) {
+    for ( ; (_next_scheduled < _scheduled.size()) && (_scheduled[_next_scheduled].time_sec <= time_sec); _next_scheduled++ ) {
+        due.push_back(_scheduled[_next_scheduled]);
+    }
+
+    if ( _rain_per_sec > 0.0f ) {
+        _rain_due += _rain_per_sec * std::max(time_sec - previous_sec, 0.0f);
+        std::uniform_real_distribution<float> column{0.0f, static_cast<float>(width)};
+        std::uniform_real_distribution<float> row{0.0f, static_cast<float>(height)};
+        for ( ; _rain_due >= 1.0f; _rain_due -= 1.0f ) {
+            due.push_back(ripple_event{time_sec, column(_rain_generator), row(_rain_generator), _wave});
+        }
+    }
+}
+
+/**
+ * \brief load a list of scripted ripples
+ *
+ * \param path path to the script
+ * \param fallback ripple parameters for lines that only give a time and position
+ * \retval std::optional<std::vector<ripple_event>> events sorted by time
+ */
+std::optional<std::vector<ripple_event>> load_ripple_script(const std::string& path, const ripple& fallback) {
+    std::ifstream file{path};
+    if ( !file ) {
+        std::cerr << "could not open ripple script " << path << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<ripple_event> events;
+    std::string line;
+    for ( int line_number = 1; std::getline(file, line); line_number++ ) {
+        const auto start = line.find_first_not_of(" \t\r");
+        if ( (start == std::string::npos) || (line[start] == '#') ) {
+            continue;
+        }
+        std::istringstream fields{line};
+        ripple_event event{0, 0, 0, fallback};
+        if ( !(fields >> event.time_sec >> event.x >> event.y) ) {
+            std::cerr << path << ":" << line_number << ": expected \"time_sec x y [impulse propagation damping]\"" << std::endl;
+            return std::nullopt;
+        }
+        float impulse = 0;
+        if ( fields >> impulse ) {
+            event.wave.impulse = impulse;
+            if ( !(fields >> event.wave.propagation >> event.wave.damping) ) {
+                std::cerr << path << ":" << line_number << ": expected propagation and damping after the impulse" << std::endl;
+                return std::nullopt;
+            }
+        }
+        events.push_back(event);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const auto& a, const auto& b) { return a.time_sec < b.time_sec; });
+    return events;
+}
@@ -0,0 +1,172 @@
+/**
+ * \file ripple_sources.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief superposition of many short lived ripples spawned at arbitrary points. Each ripple only touches the pixels within
+ *        its cutoff radius, and the field is split into tiles that only visit the ripples overlapping them. Every ripple drops
+ *        less than the threshold past its cutoff, so a pixel covered by n ripple tails is off by at most n * threshold.
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ripple.hpp"
+#include "ripple_batch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief a ripple spawned at a point in space and time
+ */
+struct ripple_event {
+    float time_sec;  //!< simulation time of the impulse
+    float x;         //!< column of the impulse in field units (pixels at the size the field was built with)
+    float y;         //!< row of the impulse in field units
+    ripple wave;
+};
+
+/**
+ * \brief the set of active spawned ripples
+ */
+class ripple_sources {
+  public:
+    /**
+     * \brief Construct a new ripple sources object
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param threshold contribution below which a ripple is ignored, in 8-bit steps. Sets both the cutoff radius and expiry.
+     * \param tile_size width and height of a culling tile in pixels
+     */
+    ripple_sources(std::size_t width, std::size_t height, float threshold = 0.5f, std::size_t tile_size = 32);
+
+    /**
+     * \brief add a ripple
+     *
+     * \param event the ripple and where and when it starts
+     */
+    void spawn(const ripple_event& event);
+
+    /**
+     * \brief remove expired ripples, compute the per-frame terms and cutoff radius of the rest and bin them into tiles
+     *
+     * \param time_sec simulation time
+     */
+    void update(float time_sec);
+
+    /**
+     * \brief add the active ripples onto a row major 8-bit field, clamping to [0, 255]. Tiles without ripples are skipped.
+     *
+     * \param pixels the field
+     */
+    void accumulate(uint8_t* pixels) const;
+
+    /**
+     * \brief add the active ripples onto a band of rows of a row major 8-bit field. Bands don't share any pixels, so
+     *        several can run at once and the result doesn't depend on how the field is split.
+     *
+     * \param pixels the whole field
+     * \param first_row first row of the band
+     * \param last_row one past the last row of the band
+     */
+    void accumulate(uint8_t* pixels, std::size_t first_row, std::size_t last_row) const;
+
+    /**
+     * \brief change the field size. Ripples outside the new field are kept and still contribute near the edges.
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param spacing units of the ripple positions and radii per pixel
+     */
+    void resize(std::size_t width, std::size_t height, float spacing = 1.0f);
+
+    std::size_t active() const;
+
+  private:
+    struct source {
+        float x;
+        float y;
+        float cutoff_squared;  //!< squared radius past which the contribution is below the threshold
+        ripple_terms terms;
+    };
+
+    void accumulate_tile(std::size_t tile_x, std::size_t tile_y, std::size_t top, std::size_t bottom, float* sums, uint8_t* pixels) const;
+
+    std::size_t _width;
+    std::size_t _height;
+    float _spacing;
+    float _threshold;
+    std::size_t _tile_size;
+    std::size_t _tiles_x;
+    std::size_t _tiles_y;
+    std::vector<ripple_event> _events;              //!< spawned ripples that have not expired
+    std::vector<source> _sources;                   //!< per-frame state of each ripple in _events
+    std::vector<std::vector<uint32_t>> _tile_bins;  //!< indices into _sources that overlap each tile
+};
+
+/**
+ * \brief decides when scripted and random ripples spawn. The field engines own one and spawn whatever it hands them.
+ */
+class ripple_spawner {
+  public:
+    /**
+     * \brief Construct a new ripple spawner object
+     *
+     * \param wave ripple parameters for rain drops
+     */
+    explicit ripple_spawner(const ripple& wave);
+
+    /**
+     * \brief schedule ripples to spawn once the simulation reaches their time
+     *
+     * \param events ripples sorted by time
+     */
+    void schedule(std::vector<ripple_event>&& events);
+
+    /**
+     * \brief spawn ripples at random positions at a steady rate. The generator is seeded so that runs are repeatable.
+     *
+     * \param per_sec ripples per simulated second
+     */
+    void set_rain(float per_sec);
+
+    /**
+     * \brief append the ripples due between two points in time
+     *
+     * \param previous_sec time of the previous update
+     * \param time_sec current simulation time
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param due the ripples that should spawn now
+     */
+    void collect(float previous_sec, float time_sec, std::size_t width, std::size_t height, std::vector<ripple_event>& due);
+
+  private:
+    ripple _wave;
+    std::vector<ripple_event> _scheduled;
+    std::size_t _next_scheduled;
+    float _rain_per_sec;
+    float _rain_due;  //!< fractional ripples carried between frames
+    std::mt19937 _rain_generator;
+};
+
+/********************************** Functions *******************************************/
+/**
+ * \brief load a list of scripted ripples. Each line is "time_sec x y [impulse propagation damping]", blank lines and
+ *        lines starting with '#' are skipped.
+ *
+ * \param path path to the script
+ * \param fallback ripple parameters for lines that only give a time and position
+ * \retval std::optional<std::vector<ripple_event>> events sorted by time, or nothing if the file can't be read or a line
+ *         is malformed
+ */
+std::optional<std::vector<ripple_event>> load_ripple_script(const std::string& path, const ripple& fallback);
@@ -0,0 +1,360 @@
+/**
+ * \file wave_field.cpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief finite difference solver for the damped 2D wave equation that creates an 8-bit height field
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+/********************************** Includes *******************************************/
+#include "wave_field.hpp"
+#include "ripple_batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+/********************************** Constants *******************************************/
+constexpr float steps_per_sec = 120.0f;        //!< fixed solver rate, independent of the frame rate
+constexpr uint64_t max_steps_per_update = 8;   //!< steps beyond this are dropped so a stalled frame can't snowball
+constexpr float courant_squared = 0.25f;       //!< (speed * dt / dx)^2, stable up to 0.5 for the 5-point stencil
+constexpr float rest_level = 128.0f;           //!< output value of the surface at rest
+constexpr float drop_scale = 1.0f;             //!< drop height per unit of impulse. A fresh drop clips for a few frames, but
+                                               //!< the rings it sends out are a small fraction of its height.
+constexpr float settled_height = 1.0f / 64.0f;  //!< surface is flattened once every cell is closer to rest than this
+constexpr float min_drop_sigma = 1.0f;
+constexpr float max_drop_sigma = 32.0f;
+
+/********************************** Function Definitions *******************************************/
+/**
+ * \brief Construct a new wave field object with a drop in the middle of the field
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ * \param wave the ripple parameters of the initial drop and of rain
+ * \param threads threads used to step and fill the field. Zero uses the hardware concurrency.
+ */
+wave_field::wave_field(std::size_t width, std::size_t height, const ripple& wave, unsigned threads)
+    : _width(width)
+    , _height(height)
+    , _stride(width + 2)
+    , _previous(_stride * (height + 2), 0.0f)
+    , _current(_stride * (height + 2), 0.0f)
+    , _row_peaks(height, 0.0f)
+    , _settled(false)
+    , _disturbed(true)
+    , _extent_width(width)
+    , _extent_height(height)
+    , _spacing(1.0f)
+    , _wave(wave)
+    , _time_sec(0)
+    , _steps(0)
+    , _pool(std::make_unique<worker_pool>(threads))
+    , _spawner(wave) {
+    //!< the buffers never grow past the size the field was built with, so resampling never allocates
+    _scratch.reserve(_current.size());
+    //!< next = decay * (2 * current - previous + c^2 * laplacian). An oscillation loses sqrt(decay) per step, so the
+    //!< square of the per-step amplitude decay exp(-damping * dt) makes crests fall off like the closed form ripple.
+    _decay = std::exp(-2.0f * std::max(wave.damping, 0.0f) / steps_per_sec);
+    _center_weight = _decay * (2.0f - 4.0f * courant_squared);
+    _neighbour_weight = _decay * courant_squared;
+    drop(static_cast<float>(width / 2), static_cast<float>(height / 2), _wave);
+}
+
+/**
+ * \brief step the solver up to a new point in time. Ripples due this frame drop before the first step.
+ *
+ * \param time_sec simulation time in seconds
+ * \retval true if the output changed
+ */
+bool wave_field::update(double time_sec) {
+    const auto previous_sec = _time_sec;
+    _time_sec = static_cast<float>(time_sec);
+
+    _due.clear();
+    _spawner.collect(previous_sec, _time_sec, _extent_width, _extent_height, _due);
+    for ( const auto& event : _due ) {
+        drop(event.x, event.y, event.wave);
+    }
+
+    const auto target = static_cast<uint64_t>(std::max(time_sec, 0.0) * steps_per_sec);
+    const auto disturbed = std::exchange(_disturbed, false);
+    if ( _settled || (target <= _steps) ) {
+        _steps = std::max(_steps, target);
+        return disturbed;
+    }
+    const auto steps = std::min(target - _steps, max_steps_per_update);
+    _steps = target;
+
+    for ( uint64_t i = 0; i < steps; i++ ) {
+        _pool->for_each_band(_height, [this](std::size_t first, std::size_t last) { step(first, last); });
+        for ( const auto index : _obstacle_cells ) {
+            _previous[index] = 0.0f;
+        }
+        std::swap(_previous, _current);
+    }
+
+    //!< the damping only approaches rest, so snap the surface flat once it can no longer move a pixel and stop stepping
+    if ( _row_peaks.empty() || (*std::max_element(_row_peaks.begin(), _row_peaks.end()) < settled_height) ) {
+        std::fill(_previous.begin(), _previous.end(), 0.0f);
+        std::fill(_current.begin(), _current.end(), 0.0f);
+        _settled = true;
+    }
+    return true;
+}
+
+/**
+ * \brief write the field into a row major 8-bit buffer of width * height pixels, with rest at 128
+ *
+ * \param pixels the output buffer
+ */
+void wave_field::fill(uint8_t* pixels) const {
+    _pool->for_each_band(_height, [this, pixels](std::size_t first, std::size_t last) {
+        for ( auto row = first; row < last; row++ ) {
+            const float* heights = _current.data() + (row + 1) * _stride + 1;
+            uint8_t* output = pixels + row * _width;
+            std::size_t column = 0;
+#if defined(FAST_MATH_SSE2)
+            //!< the saturating packs clamp to [0, 255], so sixteen pixels narrow with no explicit min/max
+            const auto rest = _mm_set1_ps(rest_level);
+            for ( ; column + 16 <= _width; column += 16 ) {
+                const auto a = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(heights + column), rest));
+                const auto b = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(heights + column + 4), rest));
+                const auto c = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(heights + column + 8), rest));
+                const auto d = _mm_cvttps_epi32(_mm_add_ps(_mm_loadu_ps(heights + column + 12), rest));
+                const auto bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + column), bytes);
+            }
+#endif
+            for ( ; column < _width; column++ ) {
+                output[column] = to_pixel(heights[column] + rest_level);
+            }
+        }
+    });
+}
+
+/**
+ * \brief change the resolution of the field, resampling the surface and rebuilding the obstacles
+ *
+ * \param width width of the field in pixels
+ * \param height height of the field in pixels
+ */
+void wave_field::resize(std::size_t width, std::size_t height) {
+    resample(_previous, width, height);
+    resample(_current, width, height);
+    _width = width;
+    _height = height;
+    _stride = width + 2;
+    _row_peaks.assign(height, 0.0f);
+    _spacing = static_cast<float>(_extent_width) / static_cast<float>(std::max<std::size_t>(width, 1));
+
+    //!< hold the wave speed in field units per second: c^2 in cells per step shrinks with the square of the spacing
+    const auto courant = courant_squared / (_spacing * _spacing);
+    _center_weight = _decay * (2.0f - 4.0f * courant);
+    _neighbour_weight = _decay * courant;
+    build_obstacles();
+    _disturbed = true;
+}
+
+/**
+ * \brief drop a ripple onto the surface at the current simulation time
+ *
+ * \param x column in field pixels
+ * \param y row in field pixels
+ * \param wave the ripple parameters
+ */
+void wave_field::spawn(float x, float y, const ripple& wave) {
+    drop(x * _spacing, y * _spacing, wave);
+}
+
+/**
+ * \brief place a circular obstacle that holds the surface at rest
+ *
+ * \param x column of the center in field pixels
+ * \param y row of the center in field pixels
+ * \param radius radius in field pixels
+ */
+void wave_field::add_obstacle(float x, float y, float radius) {
+    _obstacles.push_back(obstacle{x * _spacing, y * _spacing, radius * _spacing});
+    build_obstacles();
+    _disturbed = true;
+}
+
+/**
+ * \brief schedule ripples to drop once the simulation reaches their time
+ *
+ * \param events ripples sorted by time
+ */
+void wave_field::schedule(std::vector<ripple_event>&& events) {
+    _spawner.schedule(std::move(events));
+}
+
+/**
+ * \brief drop ripples at random positions at a steady rate
+ *
+ * \param per_sec ripples per simulated second
+ */
+void wave_field::set_rain(float per_sec) {
+    _spawner.set_rain(per_sec);
+}
+
+/**
+ * \brief get the width of the field
+ *
+ * \retval std::size_t width in pixels
+ */
+std::size_t wave_field::width() const {
+    return _width;
+}
+
+/**
+ * \brief get the height of the field
+ *
+ * \retval std::size_t height in pixels
+ */
+std::size_t wave_field::height() const {
+    return _height;
+}
+
+/**
+ * \brief advance a band of rows by one step, writing the next heights over the previous ones and the largest height of
+ *        each row. Each cell only reads its own previous value, so bands can run in parallel without sharing writes.
+ *
+ * \param first_row first row of the band
+ * \param last_row one past the last row of the band
+ */
+void wave_field::step(std::size_t first_row, std::size_t last_row) {
+    for ( auto row = first_row; row < last_row; row++ ) {
+        const float* center = _current.data() + (row + 1) * _stride + 1;
+        const float* up = center - _stride;
+        const float* down = center + _stride;
+        float* next = _previous.data() + (row + 1) * _stride + 1;
+        float peak = 0.0f;
+        std::size_t column = 0;
+#if defined(FAST_MATH_SSE2)
+        const auto sign = _mm_set1_ps(-0.0f);
+        auto peaks = _mm_setzero_ps();
+        const auto center_weight = _mm_set1_ps(_center_weight);
+        const auto neighbour_weight = _mm_set1_ps(_neighbour_weight);
+        const auto decay = _mm_set1_ps(_decay);
+        for ( ; column + 4 <= _width; column += 4 ) {
+            const auto neighbours = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(up + column), _mm_loadu_ps(down + column)),
+                                               _mm_add_ps(_mm_loadu_ps(center + column - 1), _mm_loadu_ps(center + column + 1)));
+            const auto value = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(center_weight, _mm_loadu_ps(center + column)),
+                                                     _mm_mul_ps(neighbour_weight, neighbours)),
+                                          _mm_mul_ps(decay, _mm_loadu_ps(next + column)));
+            _mm_storeu_ps(next + column, value);
+            peaks = _mm_max_ps(peaks, _mm_andnot_ps(sign, value));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, peaks);
+        peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+        for ( ; column < _width; column++ ) {
+            const auto neighbours = up[column] + down[column] + center[column - 1] + center[column + 1];
+            next[column] = _center_weight * center[column] + _neighbour_weight * neighbours - _decay * next[column];
+            peak = std::max(peak, std::fabs(next[column]));
+        }
+        _row_peaks[row] = peak;
+    }
+}
+
+/**
+ * \brief add a gaussian drop to the surface. It is added to both buffers so that the drop starts at rest.
+ *
+ * \param x column of the center in field units
+ * \param y row of the center in field units
+ * \param wave the ripple parameters
+ */
+void wave_field::drop(float x, float y, const ripple& wave) {
+    _settled = false;
+    _disturbed = true;
+    const auto amplitude = drop_scale * wave.impulse;
+    const auto extent_sigma = std::clamp(3.0f / std::max(std::fabs(wave.propagation), 1e-3f), min_drop_sigma, max_drop_sigma);
+    const auto sigma = std::max(extent_sigma / _spacing, min_drop_sigma);
+    const auto inverse_two_sigma_squared = 1.0f / (2.0f * sigma * sigma);
+    const auto reach = 3.0f * sigma;
+    x /= _spacing;
+    y /= _spacing;
+
+    const auto first_row = static_cast<std::size_t>(std::clamp(y - reach, 0.0f, static_cast<float>(_height)));
+    const auto last_row = static_cast<std::size_t>(std::clamp(y + reach + 1.0f, 0.0f, static_cast<float>(_height)));
+    const auto first_column = static_cast<std::size_t>(std::clamp(x - reach, 0.0f, static_cast<float>(_width)));
+    const auto last_column = static_cast<std::size_t>(std::clamp(x + reach + 1.0f, 0.0f, static_cast<float>(_width)));
+    for ( auto row = first_row; row < last_row; row++ ) {
+        for ( auto column = first_column; column < last_column; column++ ) {
+            const auto dx = static_cast<float>(column) - x;
+            const auto dy = static_cast<float>(row) - y;
+            const auto height = amplitude * std::exp(-(dx * dx + dy * dy) * inverse_two_sigma_squared);
+            const auto index = (row + 1) * _stride + column + 1;
+            _previous[index] += height;
+            _current[index] += height;
+        }
+    }
+    for ( const auto index : _obstacle_cells ) {
+        _previous[index] = 0.0f;
+        _current[index] = 0.0f;
+    }
+}
+
+/**
+ * \brief find the cells covered by the obstacles at the current resolution and hold them at rest
+ */
+void wave_field::build_obstacles() {
+    _obstacle_cells.clear();
+    for ( const auto& shape : _obstacles ) {
+        const auto x = shape.x / _spacing;
+        const auto y = shape.y / _spacing;
+        const auto radius = shape.radius / _spacing;
+        const auto first_row = static_cast<std::size_t>(std::clamp(y - radius, 0.0f, static_cast<float>(_height)));
+        const auto last_row = static_cast<std::size_t>(std::clamp(y + radius + 1.0f, 0.0f, static_cast<float>(_height)));
+        const auto first_column = static_cast<std::size_t>(std::clamp(x - radius, 0.0f, static_cast<float>(_width)));
+        const auto last_column = static_cast<std::size_t>(std::clamp(x + radius + 1.0f, 0.0f, static_cast<float>(_width)));
+        for ( auto row = first_row; row < last_row; row++ ) {
+            for ( auto column = first_column; column < last_column; column++ ) {
+                const auto dx = static_cast<float>(column) - x;
+                const auto dy = static_cast<float>(row) - y;
+                if ( dx * dx + dy * dy <= radius * radius ) {
+                    _obstacle_cells.push_back((row + 1) * _stride + column + 1);
+                }
+            }
+        }
+    }
+    for ( const auto index : _obstacle_cells ) {
+        _previous[index] = 0.0f;
+        _current[index] = 0.0f;
+    }
+}
+
+/**
+ * \brief bilinearly resample a padded height buffer at the current size onto a new size. The border stays at rest.
+ *
+ * \param heights padded buffer of the current size, replaced with the resampled one
+ * \param width new width in pixels
+ * \param height new height in pixels
+ */
+void wave_field::resample(std::vector<float>& heights, std::size_t width, std::size_t height) {
+    const auto stride = width + 2;
+    _scratch.assign(stride * (height + 2), 0.0f);
+    const auto x_scale = static_cast<float>(_width) / static_cast<float>(std::max<std::size_t>(width, 1));
+    const auto y_scale = static_cast<float>(_height) / static_cast<float>(std::max<std::size_t>(height, 1));
+    for ( std::size_t row = 0; row < height; row++ ) {
+        //!< sample at pixel centers, in padded coordinates so the border supplies the rest value at the edges
+        const auto y = std::clamp((static_cast<float>(row) + 0.5f) * y_scale + 0.5f, 0.0f, static_cast<float>(_height + 1));
+        const auto y0 = std::min(static_cast<std::size_t>(y), _height);
+        const auto fy = y - static_cast<float>(y0);
+        for ( std::size_t column = 0; column < width; column++ ) {
+            const auto x = std::clamp((static_cast<float>(column) + 0.5f) * x_scale + 0.5f, 0.0f, static_cast<float>(_width + 1));
+            const auto x0 = std::min(static_cast<std::size_t>(x), _width);
+            const auto fx = x - static_cast<float>(x0);
+            const float* top = heights.data() + y0 * _stride + x0;
+            const float* bottom = top + _stride;
+            const auto upper = top[0] + fx * (top[1] - top[0]);
+            const auto lower = bottom[0] + fx * (bottom[1] - bottom[0]);
+            _scratch[(row + 1) * stride + column + 1] = upper + fy * (lower - upper);
+        }
+    }
+    std::swap(heights, _scratch);
+}
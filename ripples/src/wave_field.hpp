@@ -0,0 +1,139 @@
+/**
+ * \file wave_field.hpp
+ * \author Graham Riches (graham.riches@live.com)
+ * \brief finite difference solver for the damped 2D wave equation that creates an 8-bit height field
+ * \version 0.1
+ * \date 2026-10-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+
+/********************************** Includes *******************************************/
+#include "ripple.hpp"
+#include "ripple_sources.hpp"
+#include "worker_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/********************************** Types *******************************************/
+/**
+ * \brief height field engine that integrates the damped wave equation instead of evaluating the closed form ripple, so
+ *        waves reflect off the edges of the field and off obstacles and interfere with each other. Heights live in two
+ *        padded float buffers: each step writes the next state over the previous one with a 5-point stencil and the
+ *        buffers swap. Rows are split into bands across a worker pool. A ripple disturbs the surface with a gaussian drop:
+ *        the impulse sets its height and the propagation its width (wider drops make longer waves). The damping of the
+ *        field's own ripple sets how fast the whole surface settles. The output is centered on 128 so that troughs as well as crests reach the shader.
+ */
+class wave_field {
+  public:
+    /**
+     * \brief Construct a new wave field object with a drop in the middle of the field
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     * \param wave the ripple parameters of the initial drop and of rain
+     * \param threads threads used to step and fill the field. Zero uses the hardware concurrency.
+     */
+    wave_field(std::size_t width, std::size_t height, const ripple& wave, unsigned threads = 0);
+
+    /**
+     * \brief step the solver up to a new point in time
+     *
+     * \param time_sec simulation time in seconds
+     * \retval true if the output changed. Once the surface has settled the solver stops stepping and this returns false
+     *         until the next drop.
+     */
+    bool update(double time_sec);
+
+    /**
+     * \brief write the field into a row major 8-bit buffer of width * height pixels
+     *
+     * \param pixels the output buffer
+     */
+    void fill(uint8_t* pixels) const;
+
+    /**
+     * \brief change the resolution of the field. The field keeps the extent it was built with: the surface is resampled,
+     *        and the wave speed, drops and obstacles scale with the spacing between pixels so they look the same on screen.
+     *
+     * \param width width of the field in pixels
+     * \param height height of the field in pixels
+     */
+    void resize(std::size_t width, std::size_t height);
+
+    /**
+     * \brief drop a ripple onto the surface at the current simulation time
+     *
+     * \param x column in field pixels
+     * \param y row in field pixels
+     * \param wave the ripple parameters
+     */
+    void spawn(float x, float y, const ripple& wave);
+
+    /**
+     * \brief place a circular obstacle that holds the surface at rest
+     *
+     * \param x column of the center in field pixels
+     * \param y row of the center in field pixels
+     * \param radius radius in field pixels
+     */
+    void add_obstacle(float x, float y, float radius);
+
+    /**
+     * \brief schedule ripples to drop once the simulation reaches their time
+     *
+     * \param events ripples sorted by time
+     */
+    void schedule(std::vector<ripple_event>&& events);
+
+    /**
+     * \brief drop ripples at random positions at a steady rate
+     *
+     * \param per_sec ripples per simulated second
+     */
+    void set_rain(float per_sec);
+
+    std::size_t width() const;
+    std::size_t height() const;
+
+  private:
+    struct obstacle {
+        float x;       //!< column of the center in field units
+        float y;       //!< row of the center in field units
+        float radius;  //!< radius in field units
+    };
+
+    void step(std::size_t first_row, std::size_t last_row);
+    void drop(float x, float y, const ripple& wave);
+    void build_obstacles();
+    void resample(std::vector<float>& heights, std::size_t width, std::size_t height);
+
+    std::size_t _width;
+    std::size_t _height;
+    std::size_t _stride;            //!< padded row length. The border cells are never written, which makes the edges walls.
+    std::vector<float> _previous;   //!< heights one step ago, overwritten with the next step
+    std::vector<float> _current;    //!< heights now
+    std::vector<float> _scratch;    //!< resampling buffer
+    std::vector<float> _row_peaks;  //!< largest height in each row after the last step
+    bool _settled;                  //!< the surface is flat and the solver is not stepping
+    bool _disturbed;                //!< the surface changed outside of a step since the last update
+    std::vector<obstacle> _obstacles;
+    std::vector<std::size_t> _obstacle_cells;  //!< padded indices of cells held at rest
+    std::size_t _extent_width;      //!< size the field was built with. Drop and obstacle positions are in these units.
+    std::size_t _extent_height;
+    float _spacing;                 //!< extent units per pixel
+    ripple _wave;
+    float _decay;                   //!< per-step damping of the surface
+    float _center_weight;           //!< stencil weight of the cell itself
+    float _neighbour_weight;        //!< stencil weight of each of the four neighbours
+    float _time_sec;
+    uint64_t _steps;                //!< solver steps taken since time zero
+    std::unique_ptr<worker_pool> _pool;
+    ripple_spawner _spawner;
+    std::vector<ripple_event> _due;  //!< scratch list of ripples dropping this frame
+};
@@ -12,6 +12,9 @@
 #pragma once
 
 /********************************** Includes *******************************************/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <vector>
 #include <utility>
@@ -43,16 +46,16 @@ std::vector<std::vector<T>> random_seed(int width, int height, std::function<T(v
 }
 
  /**
- * \brief create a random seeded grid of booleans
+ * \brief create a random seeded grid of booleans from a fixed seed, so the same seed always gives the same grid
  * 
  * \param width how many columns in the grid
  * \param height how many row in the grid
  * \param density seeding density
+ * \param seed seed for the random engine
  * \retval game_of_life 
  */
-inline std::vector<std::vector<bool>> random_boolean_grid(int width, int height, int density=30) {    
-    std::random_device random_device;
-    std::mt19937 random_engine(random_device());
+inline std::vector<std::vector<bool>> random_boolean_grid(int width, int height, int density, std::mt19937::result_type seed) {    
+    std::mt19937 random_engine(seed);
     std::uniform_int_distribution<int> distribution(0, 100);
 
     //!< lambda to bind the arguments for the distribution
@@ -62,6 +65,19 @@ inline std::vector<std::vector<bool>> random_boolean_grid(int width, int height,
     return random_seed(width, height, get_bool);
 }
 
+ /**
+ * \brief create a random seeded grid of booleans that is different on every call
+ * 
+ * \param width how many columns in the grid
+ * \param height how many row in the grid
+ * \param density seeding density
+ * \retval game_of_life 
+ */
+inline std::vector<std::vector<bool>> random_boolean_grid(int width, int height, int density=30) {    
+    std::random_device random_device;
+    return random_boolean_grid(width, height, density, random_device());
+}
+
 
 /**
 * \brief create a random seeded grid of integers
@@ -158,4 +174,106 @@ class game_of_life {
     int _rows;
     int _columns;
     std::vector<std::vector<bool>> _tiles;    
-};
\ No newline at end of file
+};
+
+/**
+ * \brief height field engine that steps a game of life at a fixed sample rate and renders live cells as
+ *        full height pixels. This has no dependencies on open frameworks so that it can run headless.
+ */
+class conway_field {
+  public:
+    /**
+     * \brief Construct a new conway field object
+     *
+     * \param seed arena seed that contains the initial generation
+     * \param sample_rate_ms time between generations in milliseconds
+     */
+    conway_field(std::vector<std::vector<bool>>&& seed, uint64_t sample_rate_ms)
+    : _rows(seed.size())
+    , _columns((seed.size() >= 1) ? seed[0].size() : 0)
+    , _output_rows(_rows)
+    , _output_columns(_columns)
+    , _generation(seed)
+    , _conway(std::move(seed))
+    , _sample_rate_sec(sample_rate_ms / 1000.0)
+    , _last_sample_time(0)
+    , _started(false) { }
+
+    /**
+     * \brief advance the simulation to a new point in time. A new generation is created every time the sample period elapses.
+     *
+     * \param time_sec simulation time in seconds
+     * \retval true if the output changed
+     */
+    bool update(double time_sec) {
+        if (!_started) {
+            _started = true;
+            _last_sample_time = time_sec;
+            return true;
+        }
+        if ((time_sec - _last_sample_time) >= _sample_rate_sec) {
+            _last_sample_time = time_sec;
+            _generation = _conway.next_generation();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * \brief write the current generation into a row major 8-bit buffer of width() * height() pixels. When the output
+     *        is smaller than the arena each pixel covers a block of cells and is lit if any cell in the block is alive.
+     *
+     * \param pixels the output buffer
+     */
+    void fill(uint8_t* pixels) const {
+        if ((_output_rows == _rows) && (_output_columns == _columns)) {
+            for (std::size_t row = 0; row < _rows; row++) {
+                for (std::size_t column = 0; column < _columns; column++) {
+                    pixels[row * _columns + column] = _generation[row][column] * 255;
+                }
+            }
+            return;
+        }
+        for (std::size_t row = 0; row < _output_rows; row++) {
+            const auto first_row = row * _rows / _output_rows;
+            const auto last_row = std::max((row + 1) * _rows / _output_rows, first_row + 1);
+            for (std::size_t column = 0; column < _output_columns; column++) {
+                const auto first_column = column * _columns / _output_columns;
+                const auto last_column = std::max((column + 1) * _columns / _output_columns, first_column + 1);
+                bool alive = false;
+                for (auto r = first_row; (r < last_row) && !alive; r++) {
+                    for (auto c = first_column; (c < last_column) && !alive; c++) {
+                        alive = _generation[r][c];
+                    }
+                }
+                pixels[row * _output_columns + column] = alive * 255;
+            }
+        }
+    }
+
+    /**
+     * \brief change the output resolution. The arena keeps its full size and keeps simulating every cell, only fill
+     *        resamples it, so stepping the resolution down and back up never loses cells.
+     *
+     * \param width output width in pixels
+     * \param height output height in pixels
+     */
+    void resize(std::size_t width, std::size_t height) {
+        _output_columns = width;
+        _output_rows = height;
+    }
+
+    std::size_t width() const { return _output_columns; }
+    std::size_t height() const { return _output_rows; }
+
+  private:
+    std::size_t _rows;
+    std::size_t _columns;
+    std::size_t _output_rows;     //!< resolution fill writes at, the arena size unless adaptive resolution lowered it
+    std::size_t _output_columns;
+    std::vector<std::vector<bool>> _generation;
+    game_of_life _conway;
+    double _sample_rate_sec;
+    double _last_sample_time;
+    bool _started;
+};
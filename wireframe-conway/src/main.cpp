@@ -12,20 +12,30 @@
 /********************************** Includes *******************************************/
 #include "ofApp.h"
 #include "ofMain.h"
+#include "async_readback.hpp"
+#include "headless_runner.hpp"
+#include "sketch_options.hpp"
 #include <memory>
 
 /********************************** Functions *******************************************/
 /**
- * @brief main sketch application 
+ * @brief main sketch application. Pass --headless to run the simulation without a window
+ *        (see sketch_options.hpp for the full set of flags).
  * @return 
 */
 int main(int argc, char* argv[]) {    
+    const auto options = parse_sketch_options(argc, argv);
+    if (options.headless) {
+        conway_field field{random_boolean_grid(60, 80, grid_density, options.seed), 100};
+        return run_headless(field, options, of_image_encoder());
+    }
+
     ofGLWindowSettings window_settings;
     window_settings.setGLVersion(3, 2);
     window_settings.setSize(1600, 1200);
     ofCreateWindow(window_settings);    
 
     //!< start the application event loop
-    auto app = std::make_unique<application>(80, 60);
+    auto app = std::make_unique<application>(80, 60, 2, 100, 40, options);
     ofRunApp(app.get());
 }
@@ -10,8 +10,7 @@
  */
 
 #include "ofApp.h"
-#include <algorithm>
-#include <filesystem>
+#include "profiler_overlay.hpp"
 
 
 /**
@@ -21,90 +20,59 @@
  * \param wireframe_resolution how many wireframes per conway grid location
  * \param sample_rate time sample rate in ms
  * \param scale height scale for rendering
+ * \param options sketch options for the clock, threading and profiler
 */
-application::application(int width, int height, int wireframe_resolution, uint64_t sample_rate, float scale)
-: _conway(game_of_life{random_boolean_grid(height, width, grid_density)})
-, _width(width)
-, _height(height)
-, _sample_rate_ms(sample_rate)
+application::application(int width, int height, int wireframe_resolution, uint64_t sample_rate, float scale, const sketch_options& options)
+: _view(conway_field{random_boolean_grid(height, width, grid_density), sample_rate},
+        heightfield_settings{1200, 900, height * wireframe_resolution, height * wireframe_resolution, "shadersGL3/shader", "scale"},
+        options)
+, _clock(options.make_clock())
 , _scale(scale)
-, _last_sample_time(0)
-{
-    _image.allocate(height, width, OF_IMAGE_GRAYSCALE);
-    _plane.set(1200, 900, height*wireframe_resolution, height*wireframe_resolution, OF_PRIMITIVE_TRIANGLES);
-    _plane.mapTexCoordsFromTexture(_image.getTexture());
-}   
+{ }
 
 /**
  * \brief open frameworks setup function that runs prior to the main event loop
  */
 void application::setup() {    
-    auto path = std::filesystem::current_path();
-    auto parent_path = path.parent_path();
-    std::filesystem::path shader_path = parent_path / std::filesystem::path{"shaders"};
-    _displacement_shader.load(shader_path / std::filesystem::path{"shadersGL3/shader"});    
+    _view.setup();
 }
 
 /**
  * \brief frame update method
  */
 void application::update() {
-    const auto elapsed_time_ms = ofGetElapsedTimeMillis();
-    if ((elapsed_time_ms - _last_sample_time) / _sample_rate_ms) {
-        //!< update timestamp
-        _last_sample_time = elapsed_time_ms;
-
-        //!< get the next generation
-        auto current_generation = _conway.next_generation();
-        
-        //!< update the image to draw it
-        ofPixels& pixels = _image.getPixels();
-        const auto width = _image.getWidth();
-        const auto height = _image.getHeight();        
-        for ( uint64_t row = 0; row < height; row++ ) {
-            for ( uint64_t column = 0; column < width; column++ ) {
-                pixels[row * static_cast<int>(width) + column] = current_generation[row][column]*255;
-            }
-        }
-        _image.update();
-    }
+    //!< step the simulation, a new generation is uploaded when available
+    _view.update(_clock.tick());
 }
 
 /**
  * \brief main method to render the scene
  */
 void application::draw() {
-    //!< bind the texture to the shader
-    _image.getTexture().bind();
-    
-    auto time = ofGetElapsedTimef();
+    auto time = _clock.seconds();
     auto percent_y = ofClamp(0.5 * sin(time) + 0.5, 0, 1) * _scale;
+    _view.draw(percent_y);
+}
 
-    //!< start the shader
-    _displacement_shader.begin();
-
-    _displacement_shader.setUniform1f("scale", percent_y);
-
-    //!< push the current local coordinate system to move to a new relative one
-    ofPushMatrix();
-
-    //!< translate the plane into the center of the screen
-    auto center_x = ofGetWidth() / 2.0;
-    auto center_y = ofGetHeight() / 2.0;
-    ofTranslate(center_x, center_y);
-
-    //!< rotate it to a more isometric view
-    auto rotation = ofMap(0.30, 0, 1, -60, 60, true) + 60;
-    ofRotateDeg(rotation, 1, 0, 0);
-
-    //!< draw the wireframe
-    _plane.drawWireframe();
-
-    ofPopMatrix();
-    _displacement_shader.end();
+/**
+ * \brief finish any recording and dump recorded profiler samples when the application closes
+ */
+void application::exit() {
+    _view.finish_recording();
+    dump_profiler(_view.profiler(), "wireframe_conway_profile");
 }
 
-void application::keyPressed(int key) { }
+/**
+ * \brief key handler. 'p' toggles the frame profiler and its overlay, 'r' pauses and resumes recording
+ * \param key the key that was pressed
+ */
+void application::keyPressed(int key) {
+    if (key == 'p') {
+        _view.profiler().set_enabled(!_view.profiler().enabled());
+    } else if (key == 'r') {
+        _view.toggle_recording();
+    }
+}
 
 void application::keyReleased(int key) { }
 
@@ -14,6 +14,9 @@
 /********************************** Includes *******************************************/
 #include "ofMain.h"
 #include "conway.h"
+#include "heightfield_view.hpp"
+#include "simulation_clock.hpp"
+#include "sketch_options.hpp"
 #include <cstdint>
 
 /********************************** Constants *******************************************/
@@ -22,12 +25,18 @@ constexpr int grid_density = 20;
 /********************************** Types *******************************************/
 class application : public ofBaseApp {
   public:
-    application(int width, int height, int wireframe_resolution = 2, uint64_t sample_rate = 100, float scale=40);
+    application(int width,
+                int height,
+                int wireframe_resolution = 2,
+                uint64_t sample_rate = 100,
+                float scale = 40,
+                const sketch_options& options = sketch_options{});
 
     //!< open frameworks application interface functions
     void setup();
     void update();
     void draw();
+    void exit();
     void keyPressed(int key);
     void keyReleased(int key);
     void mouseMoved(int x, int y);
@@ -41,13 +50,7 @@ class application : public ofBaseApp {
     void gotMessage(ofMessage msg);
 
   private:
-    ofShader _displacement_shader;    
-    ofPlanePrimitive _plane;    
-    ofImage _image;
-    game_of_life _conway;    
-    int _width;
-    int _height;
+    heightfield_view<conway_field> _view;
+    simulation_clock _clock;
     float _scale;
-    uint64_t _sample_rate_ms;
-    uint64_t _last_sample_time;
 };